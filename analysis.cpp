@@ -0,0 +1,157 @@
+#include "analysis.h"
+#include "solver.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// En dessous de cette taille, réveiller les threads coûte plus que l'analyse
+const size_t PARALLEL_THRESHOLD = 1 << 16;
+const size_t CHUNK_SIZE = 1 << 12;
+
+unsigned requestedThreads = 0;
+
+// Analyse d'une tranche [begin, end), renvoie le nombre de positions valides
+size_t analyzeRange(const ttt_position* positions, ttt_result* results, size_t begin, size_t end) {
+    size_t valid = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        const ttt_position& position = positions[i];
+        ttt_result& result = results[i];
+
+        if (!isValidPosition(position.x, position.o, position.to_move)) {
+            result.value = 0;
+            result.distance = 0;
+            result.best_moves = 0;
+            result.status = TTT_INVALID;
+            continue;
+        }
+
+        const SolvedPosition& solved = solvePosition(position.x, position.o, position.to_move);
+        result.value = solved.value;
+        result.distance = solved.distance;
+        result.best_moves = solved.bestMoves;
+        result.status = isTerminalPosition(position.x, position.o) ? TTT_TERMINAL : TTT_OK;
+        valid++;
+    }
+    return valid;
+}
+
+// Pool de threads créé une fois, les lots sont découpés en tranches par un compteur atomique
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threadCount)
+        : positions(nullptr), results(nullptr), count(0), generation(0), pending(0), stopping(false) {
+        for (unsigned i = 0; i < threadCount; i++) {
+            workers.emplace_back(&WorkerPool::workerLoop, this);
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    size_t analyze(const ttt_position* batchPositions, ttt_result* batchResults, size_t batchCount) {
+        std::lock_guard<std::mutex> batchLock(batchMutex);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            positions = batchPositions;
+            results = batchResults;
+            count = batchCount;
+            next.store(0);
+            valid.store(0);
+            pending = static_cast<int>(workers.size());
+            generation++;
+        }
+        wake.notify_all();
+
+        // Le thread appelant participe aussi
+        processChunks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        return valid.load();
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex batchMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const ttt_position* positions;
+    ttt_result* results;
+    size_t count;
+    std::atomic<size_t> next;
+    std::atomic<size_t> valid;
+    unsigned long generation;
+    int pending;
+    bool stopping;
+
+    void processChunks() {
+        size_t localValid = 0;
+        for (;;) {
+            size_t begin = next.fetch_add(CHUNK_SIZE);
+            if (begin >= count) break;
+            size_t end = begin + CHUNK_SIZE < count ? begin + CHUNK_SIZE : count;
+            localValid += analyzeRange(positions, results, begin, end);
+        }
+        valid.fetch_add(localValid);
+    }
+
+    void workerLoop() {
+        unsigned long seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+
+            processChunks();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending--;
+            }
+            done.notify_one();
+        }
+    }
+};
+
+WorkerPool& workerPool() {
+    static WorkerPool pool(requestedThreads > 0
+        ? requestedThreads - 1
+        : (std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0));
+    return pool;
+}
+
+}
+
+extern "C" {
+
+// Analyse d'un lot de positions
+size_t ttt_analyze_batch(const ttt_position* positions, ttt_result* results, size_t count) {
+    if (count < PARALLEL_THRESHOLD) {
+        return analyzeRange(positions, results, 0, count);
+    }
+    return workerPool().analyze(positions, results, count);
+}
+
+// Choisir le nombre de threads du pool
+void ttt_set_thread_count(unsigned threads) {
+    requestedThreads = threads;
+}
+
+}
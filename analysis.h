@@ -0,0 +1,45 @@
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// API C d'analyse de positions 3x3 par lots.
+// Les cases sont numérotées de 0 à 8, ligne par ligne (bit i = case i).
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ttt_position {
+    uint16_t x;         // cases de X
+    uint16_t o;         // cases de O
+    uint8_t to_move;    // 1 = X, 2 = O
+} ttt_position;
+
+typedef struct ttt_result {
+    int8_t value;           // pour le joueur au trait : 1 gain, 0 nul, -1 perte
+    int8_t distance;        // demi-coups jusqu'à la fin avec un jeu parfait
+    uint16_t best_moves;    // masque des meilleurs coups
+    int8_t status;          // TTT_OK, TTT_TERMINAL ou TTT_INVALID
+} ttt_result;
+
+enum {
+    TTT_OK = 0,
+    TTT_TERMINAL = 1,
+    TTT_INVALID = 2     // position impossible dans une partie (pierres, joueur au trait ou ligne incohérents)
+};
+
+// Analyse count positions ; results doit contenir count entrées.
+// Sans allocation : les gros lots sont répartis sur un pool de threads persistant.
+// Renvoie le nombre de positions valides.
+size_t ttt_analyze_batch(const ttt_position* positions, ttt_result* results, size_t count);
+
+// Nombre de threads du pool (0 = nombre de cœurs), à appeler avant la première analyse
+void ttt_set_thread_count(unsigned threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
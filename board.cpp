@@ -0,0 +1,85 @@
+#include "board.h"
+
+// Constructeur : tables construites à l'exécution
+RuntimeBoard::RuntimeBoard(int size, int align)
+    : size(size),
+      cellCount(size * size),
+      cellLines(size * size),
+      symmetries(8, std::vector<int>(size * size)) {
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+
+    for (int d = 0; d < 4; d++) {
+        int dr = directions[d][0];
+        int dc = directions[d][1];
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) {
+                int endRow = row + (align - 1) * dr;
+                int endCol = col + (align - 1) * dc;
+                if (endRow < 0 || endRow >= size || endCol < 0 || endCol >= size) continue;
+
+                uint64_t mask = 0;
+                for (int i = 0; i < align; i++) {
+                    int cell = (row + i * dr) * size + col + i * dc;
+                    mask |= uint64_t(1) << cell;
+                    cellLines[cell].push_back(static_cast<int>(lines.size()));
+                }
+                lines.push_back(mask);
+            }
+        }
+    }
+
+    int m = size - 1;
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            int cell = row * size + col;
+            symmetries[0][cell] = row * size + col;
+            symmetries[1][cell] = col * size + (m - row);
+            symmetries[2][cell] = (m - row) * size + (m - col);
+            symmetries[3][cell] = (m - col) * size + row;
+            symmetries[4][cell] = row * size + (m - col);
+            symmetries[5][cell] = (m - row) * size + col;
+            symmetries[6][cell] = col * size + row;
+            symmetries[7][cell] = (m - col) * size + (m - row);
+        }
+    }
+}
+
+// Nombre de lignes gagnantes
+int RuntimeBoard::lineCount() const {
+    return static_cast<int>(lines.size());
+}
+
+// Une ligne complète parmi les pierres
+bool RuntimeBoard::hasLine(uint64_t stones) const {
+    for (uint64_t line : lines) {
+        if ((stones & line) == line) return true;
+    }
+    return false;
+}
+
+// Une ligne complète passant par cell
+bool RuntimeBoard::hasLineThrough(uint64_t stones, int cell) const {
+    for (int index : cellLines[cell]) {
+        if ((stones & lines[index]) == lines[index]) return true;
+    }
+    return false;
+}
+
+// Image des pierres par une symétrie
+uint64_t RuntimeBoard::transform(uint64_t stones, int symmetry) const {
+    uint64_t result = 0;
+    for (int cell = 0; cell < cellCount; cell++) {
+        if ((stones >> cell) & 1) result |= uint64_t(1) << symmetries[symmetry][cell];
+    }
+    return result;
+}
+
+// Clé identique pour les 8 positions symétriques
+uint64_t RuntimeBoard::canonicalKey(uint64_t x, uint64_t o) const {
+    uint64_t best = ~uint64_t(0);
+    for (int s = 0; s < 8; s++) {
+        uint64_t key = transform(x, s) | (transform(o, s) << cellCount);
+        if (key < best) best = key;
+    }
+    return best;
+}
@@ -0,0 +1,215 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Règles d'une grille N x N où il faut aligner K pierres.
+// Les tables (lignes gagnantes, lignes passant par chaque case, symétries)
+// sont calculées à la compilation ; les tests sont déroulés sur ces tables.
+// Case : ligne * N + colonne, bit i du masque = case i.
+
+namespace board_detail {
+
+template <int N, int K>
+constexpr int lineCount() {
+    return 2 * N * (N - K + 1) + 2 * (N - K + 1) * (N - K + 1);
+}
+
+// Cases de chaque ligne : lignes, colonnes, diagonales, anti-diagonales
+template <int N, int K>
+constexpr std::array<std::array<int, K>, lineCount<N, K>()> lineCells() {
+    std::array<std::array<int, K>, lineCount<N, K>()> lines{};
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    int count = 0;
+
+    for (int d = 0; d < 4; d++) {
+        int dr = directions[d][0];
+        int dc = directions[d][1];
+        for (int row = 0; row < N; row++) {
+            for (int col = 0; col < N; col++) {
+                int endRow = row + (K - 1) * dr;
+                int endCol = col + (K - 1) * dc;
+                if (endRow < 0 || endRow >= N || endCol < 0 || endCol >= N) continue;
+                for (int i = 0; i < K; i++) {
+                    lines[count][i] = (row + i * dr) * N + col + i * dc;
+                }
+                count++;
+            }
+        }
+    }
+    return lines;
+}
+
+template <int N, int K, typename Mask>
+constexpr std::array<Mask, lineCount<N, K>()> lineMasks() {
+    std::array<Mask, lineCount<N, K>()> masks{};
+    auto cells = lineCells<N, K>();
+    for (int i = 0; i < lineCount<N, K>(); i++) {
+        for (int j = 0; j < K; j++) {
+            masks[i] |= Mask(1) << cells[i][j];
+        }
+    }
+    return masks;
+}
+
+template <int N, int K>
+constexpr std::array<int, N * N> cellLineCounts() {
+    std::array<int, N * N> counts{};
+    auto cells = lineCells<N, K>();
+    for (int i = 0; i < lineCount<N, K>(); i++) {
+        for (int j = 0; j < K; j++) {
+            counts[cells[i][j]]++;
+        }
+    }
+    return counts;
+}
+
+template <int N, int K>
+constexpr int maxCellLines() {
+    int maximum = 0;
+    auto counts = cellLineCounts<N, K>();
+    for (int cell = 0; cell < N * N; cell++) {
+        if (counts[cell] > maximum) maximum = counts[cell];
+    }
+    return maximum;
+}
+
+// Lignes passant par chaque case, complétées par -1
+template <int N, int K>
+constexpr std::array<std::array<int, maxCellLines<N, K>()>, N * N> cellLines() {
+    std::array<std::array<int, maxCellLines<N, K>()>, N * N> result{};
+    std::array<int, N * N> filled{};
+    auto cells = lineCells<N, K>();
+
+    for (int cell = 0; cell < N * N; cell++) {
+        for (int j = 0; j < maxCellLines<N, K>(); j++) result[cell][j] = -1;
+    }
+    for (int i = 0; i < lineCount<N, K>(); i++) {
+        for (int j = 0; j < K; j++) {
+            int cell = cells[i][j];
+            result[cell][filled[cell]++] = i;
+        }
+    }
+    return result;
+}
+
+// Image de chaque case par les 8 symétries du carré
+template <int N>
+constexpr std::array<std::array<int, N * N>, 8> symmetries() {
+    std::array<std::array<int, N * N>, 8> result{};
+    for (int row = 0; row < N; row++) {
+        for (int col = 0; col < N; col++) {
+            int cell = row * N + col;
+            int m = N - 1;
+            result[0][cell] = row * N + col;
+            result[1][cell] = col * N + (m - row);
+            result[2][cell] = (m - row) * N + (m - col);
+            result[3][cell] = (m - col) * N + row;
+            result[4][cell] = row * N + (m - col);
+            result[5][cell] = (m - row) * N + col;
+            result[6][cell] = col * N + row;
+            result[7][cell] = (m - col) * N + (m - row);
+        }
+    }
+    return result;
+}
+
+}
+
+template <int N, int K>
+class Board {
+    static_assert(K >= 1 && K <= N, "K doit être compris entre 1 et N");
+    static_assert(N * N <= 64, "la grille doit tenir dans 64 bits");
+
+public:
+    typedef typename std::conditional<(N * N <= 32), uint32_t, uint64_t>::type Mask;
+
+    static constexpr int SIZE = N;
+    static constexpr int ALIGN = K;
+    static constexpr int CELL_COUNT = N * N;
+    static constexpr int LINE_COUNT = board_detail::lineCount<N, K>();
+    static constexpr int MAX_CELL_LINES = board_detail::maxCellLines<N, K>();
+    static constexpr int SYMMETRY_COUNT = 8;
+    static constexpr Mask FULL = (N * N == 64) ? ~Mask(0) : static_cast<Mask>((uint64_t(1) << (N * N)) - 1);
+
+    static constexpr auto LINE_CELLS = board_detail::lineCells<N, K>();
+    static constexpr auto LINES = board_detail::lineMasks<N, K, Mask>();
+    static constexpr auto CELL_LINE_COUNTS = board_detail::cellLineCounts<N, K>();
+    static constexpr auto CELL_LINES = board_detail::cellLines<N, K>();
+    static constexpr auto SYMMETRIES = board_detail::symmetries<N>();
+
+    // Une ligne complète parmi les pierres
+    static constexpr bool hasLine(Mask stones) {
+        return anyLine(stones, std::make_index_sequence<LINE_COUNT>());
+    }
+
+    // Une ligne complète passant par cell (test après un coup)
+    static constexpr bool hasLineThrough(Mask stones, int cell) {
+        return anyLineThrough(stones, cell, std::make_index_sequence<MAX_CELL_LINES>());
+    }
+
+    // 0 en cours, 1 X aligné, 2 O aligné
+    static constexpr int winner(Mask x, Mask o) {
+        return hasLine(x) ? 1 : (hasLine(o) ? 2 : 0);
+    }
+
+    // Image des pierres par une symétrie
+    static constexpr Mask transform(Mask stones, int symmetry) {
+        return transformCells(stones, symmetry, std::make_index_sequence<CELL_COUNT>());
+    }
+
+    // Clé identique pour les 8 positions symétriques
+    static constexpr uint64_t canonicalKey(Mask x, Mask o) {
+        static_assert(2 * N * N <= 64, "clé canonique limitée aux grilles de 32 cases");
+        uint64_t best = ~uint64_t(0);
+        for (int s = 0; s < SYMMETRY_COUNT; s++) {
+            uint64_t key = uint64_t(transform(x, s)) | (uint64_t(transform(o, s)) << CELL_COUNT);
+            if (key < best) best = key;
+        }
+        return best;
+    }
+
+private:
+    template <std::size_t... I>
+    static constexpr bool anyLine(Mask stones, std::index_sequence<I...>) {
+        return (((stones & LINES[I]) == LINES[I]) || ...);
+    }
+
+    template <std::size_t... I>
+    static constexpr bool anyLineThrough(Mask stones, int cell, std::index_sequence<I...>) {
+        return ((CELL_LINES[cell][I] >= 0
+                 && (stones & LINES[CELL_LINES[cell][I]]) == LINES[CELL_LINES[cell][I]]) || ...);
+    }
+
+    template <std::size_t... I>
+    static constexpr Mask transformCells(Mask stones, int symmetry, std::index_sequence<I...>) {
+        return (((stones >> I) & 1 ? Mask(1) << SYMMETRIES[symmetry][I] : Mask(0)) | ...);
+    }
+};
+
+// Même interface, dimensions connues seulement à l'exécution (référence des mesures)
+class RuntimeBoard {
+public:
+    RuntimeBoard(int size, int align);
+
+    int lineCount() const;
+    bool hasLine(uint64_t stones) const;
+    bool hasLineThrough(uint64_t stones, int cell) const;
+    uint64_t transform(uint64_t stones, int symmetry) const;
+    uint64_t canonicalKey(uint64_t x, uint64_t o) const;
+
+private:
+    int size;
+    int cellCount;
+    std::vector<uint64_t> lines;
+    std::vector<std::vector<int>> cellLines;
+    std::vector<std::vector<int>> symmetries;
+};
+
+typedef Board<3, 3> ClassicBoard;
+
+#endif
@@ -1,14 +1,18 @@
 #include "game.h"
+#include "render_bench.h"
+#include "reference.h"
+#include "solver.h"
 #include <iostream>
 #include <sstream>
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
-#include <limits>
+#include <algorithm>
 
 // Constructeur
-Game::Game() 
-    : window(sf::VideoMode(WINDOW_SIZE, WINDOW_SIZE + SCORE_AREA_HEIGHT), "Tic-Tac-Toe"),
+Game::Game(bool headless) 
+    : surface(&window),
+      headless(headless),
       currentPlayer(1),
       gameOver(false),
       winner(0),
@@ -19,10 +23,12 @@ Game::Game()
       gameMode(PLAYER_VS_PLAYER),
       showModeSelection(true),
       hoveredCell(-1),
+      showAnalysis(false),
       hoveredButton(-1),
       firstPlayer(1),
       lastFirstPlayer(0),
-      soundsLoaded(false) {
+      soundsLoaded(false),
+      qubicNetworkLoaded(false) {
     
     std::srand(std::time(nullptr));
     
@@ -39,10 +45,23 @@ Game::Game()
     }
     
     
-    loadSounds();
+    // Sans écran, la texture de rendu (et son contexte OpenGL) n'est créée que par le banc de rendu
+    if (!headless) {
+        window.create(sf::VideoMode(WINDOW_SIZE, WINDOW_SIZE + SCORE_AREA_HEIGHT), "Tic-Tac-Toe");
+        loadSounds();
+    }
     
     createGridLines();
     createModeButtons();
+    if (!headless) {
+        createModeButtonTexts();
+    }
+    
+    // Réseau d'évaluation du Qubic (optionnel, heuristique sinon)
+    qubicNetworkLoaded = qubicNetwork.load("qubic.nnue");
+    if (qubicNetworkLoaded) {
+        std::cout << "Réseau d'évaluation Qubic chargé" << std::endl;
+    }
     
     std::cout << "Tic-Tac-Toe - Jeu démarré!" << std::endl;
 }
@@ -137,14 +156,44 @@ int Game::getCellFromPosition(int mouseX, int mouseY) {
     if (adjustedY < 0 || adjustedY >= WINDOW_SIZE) return -1;
     if (mouseX < 0 || mouseX >= WINDOW_SIZE) return -1;
     
+    // Qubic : quatre niveaux 4x4 disposés en carré
+    if (gameMode == PLAYER_VS_AI_QUBIC) {
+        int plane = (adjustedY / QUBIC_PLANE_SIZE) * 2 + mouseX / QUBIC_PLANE_SIZE;
+        int localX = mouseX % QUBIC_PLANE_SIZE - QUBIC_PLANE_MARGIN;
+        int localY = adjustedY % QUBIC_PLANE_SIZE - QUBIC_PLANE_MARGIN;
+        int gridSize = QubicBoard::SIZE * QUBIC_CELL_SIZE;
+        if (localX < 0 || localX >= gridSize || localY < 0 || localY >= gridSize) return -1;
+        
+        return plane * 16 + (localY / QUBIC_CELL_SIZE) * 4 + localX / QUBIC_CELL_SIZE;
+    }
+    
     int col = mouseX / CELL_SIZE;
     int row = adjustedY / CELL_SIZE;
     int cellIndex = row * 3 + col;
     
+    // Morpion ultime : case de la sous-grille sous le curseur
+    if (gameMode == PLAYER_VS_AI_ULTIMATE) {
+        int innerCol = (mouseX % CELL_SIZE) * 3 / CELL_SIZE;
+        int innerRow = (adjustedY % CELL_SIZE) * 3 / CELL_SIZE;
+        return cellIndex * 9 + innerRow * 3 + innerCol;
+    }
+    
     if (cellIndex >= 0 && cellIndex <= 8) return cellIndex;
     return -1;
 }
 
+// Coin supérieur gauche d'une case du Qubic
+sf::Vector2f Game::getQubicCellPosition(int cell) {
+    int plane = cell / 16;
+    int row = (cell % 16) / 4;
+    int col = cell % 4;
+    
+    return sf::Vector2f(
+        (plane % 2) * QUBIC_PLANE_SIZE + QUBIC_PLANE_MARGIN + col * QUBIC_CELL_SIZE,
+        (plane / 2) * QUBIC_PLANE_SIZE + QUBIC_PLANE_MARGIN + row * QUBIC_CELL_SIZE + SCORE_AREA_HEIGHT
+    );
+}
+
 // Créer les boutons de sélection de mode
 void Game:: createModeButtons() {
     float buttonWidth = 450;
@@ -152,18 +201,28 @@ void Game:: createModeButtons() {
     float startY = 180;
     float spacing = 90;
     
-    std::vector<std::string> buttonLabels = {
-        "Joueur vs Joueur",
-        "Joueur vs IA (Facile)",
-        "Joueur vs IA (Difficile)"
-    };
-    
-    for (int i = 0; i < 3; i++) {
+    for (int i = 0; i < MODE_BUTTON_COUNT; i++) {
         sf::RectangleShape button(sf:: Vector2f(buttonWidth, buttonHeight));
         button.setPosition((WINDOW_SIZE - buttonWidth) / 2, startY + i * spacing);
         button.setFillColor(sf::Color(52, 152, 219));
         button.setOutlineThickness(0);
         modeButtons.push_back(button);
+    }
+}
+
+// Placer les libellés des boutons (mesurer le texte charge les glyphes, donc un contexte OpenGL)
+void Game::createModeButtonTexts() {
+    std::vector<std::string> buttonLabels = {
+        "Joueur vs Joueur",
+        "Joueur vs IA (Facile)",
+        "Joueur vs IA (Difficile)",
+        "Ultime vs IA",
+        "Qubic 4x4x4 vs IA"
+    };
+    
+    modeButtonTexts.clear();
+    for (size_t i = 0; i < buttonLabels.size(); i++) {
+        sf::FloatRect button = modeButtons[i].getGlobalBounds();
         
         sf::Text text;
         text.setFont(font);
@@ -175,7 +234,7 @@ void Game:: createModeButtons() {
         sf::FloatRect textBounds = text.getLocalBounds();
         text.setPosition(
             (WINDOW_SIZE - textBounds.width) / 2 - textBounds.left,
-            startY + i * spacing + (buttonHeight - textBounds.height) / 2 - textBounds.top
+            button.top + (button.height - textBounds.height) / 2 - textBounds.top
         );
         modeButtonTexts.push_back(text);
     }
@@ -197,10 +256,46 @@ void Game::createGridLines() {
         lines.push_back(line);
     }
     
+    // Lignes fines des sous-grilles du morpion ultime
+    float innerSize = CELL_SIZE / 3.0f;
+    for (int i = 1; i < 9; i++) {
+        if (i % 3 == 0) continue;
+        
+        sf::RectangleShape vertical(sf::Vector2f(1, WINDOW_SIZE));
+        vertical.setPosition(i * innerSize, SCORE_AREA_HEIGHT);
+        vertical.setFillColor(sf::Color(189, 195, 199));
+        ultimateLines.push_back(vertical);
+        
+        sf::RectangleShape horizontal(sf::Vector2f(WINDOW_SIZE, 1));
+        horizontal.setPosition(0, i * innerSize + SCORE_AREA_HEIGHT);
+        horizontal.setFillColor(sf::Color(189, 195, 199));
+        ultimateLines.push_back(horizontal);
+    }
+    
+    // Grilles 4x4 des quatre niveaux du Qubic
+    int gridSize = QubicBoard::SIZE * QUBIC_CELL_SIZE;
+    for (int plane = 0; plane < 4; plane++) {
+        float originX = (plane % 2) * QUBIC_PLANE_SIZE + QUBIC_PLANE_MARGIN;
+        float originY = (plane / 2) * QUBIC_PLANE_SIZE + QUBIC_PLANE_MARGIN + SCORE_AREA_HEIGHT;
+        
+        for (int i = 0; i <= QubicBoard::SIZE; i++) {
+            sf::RectangleShape vertical(sf::Vector2f(2, gridSize));
+            vertical.setPosition(originX + i * QUBIC_CELL_SIZE - 1, originY);
+            vertical.setFillColor(sf::Color(189, 195, 199));
+            qubicLines.push_back(vertical);
+            
+            sf::RectangleShape horizontal(sf::Vector2f(gridSize, 2));
+            horizontal.setPosition(originX, originY + i * QUBIC_CELL_SIZE - 1);
+            horizontal.setFillColor(sf::Color(189, 195, 199));
+            qubicLines.push_back(horizontal);
+        }
+    }
+    
     sf::RectangleShape separator(sf::Vector2f(WINDOW_SIZE, 3));
     separator.setPosition(0, SCORE_AREA_HEIGHT);
     separator.setFillColor(sf::Color(149, 165, 166));
     lines.push_back(separator);
+    qubicLines.push_back(separator);
 }
 
 // Gérer le mouvement de la souris
@@ -215,7 +310,15 @@ void Game::handleMouseMove(int mouseX, int mouseY) {
         }
     } else if (! gameOver) {
         hoveredCell = getCellFromPosition(mouseX, mouseY);
-        if (hoveredCell != -1 && board[hoveredCell] != 0) {
+        if (gameMode == PLAYER_VS_AI_ULTIMATE) {
+            if (hoveredCell != -1 && !ultimate.isLegal(hoveredCell)) {
+                hoveredCell = -1;
+            }
+        } else if (gameMode == PLAYER_VS_AI_QUBIC) {
+            if (hoveredCell != -1 && !qubic.isLegal(hoveredCell)) {
+                hoveredCell = -1;
+            }
+        } else if (hoveredCell != -1 && board[hoveredCell] != 0) {
             hoveredCell = -1;
         }
     }
@@ -223,53 +326,21 @@ void Game::handleMouseMove(int mouseX, int mouseY) {
 
 // Boucle principale du jeu
 void Game::run() {
+    stats.open("stats");
+    if (!spectators.open(SpectatorPublisher::DEFAULT_CHANNEL)) {
+        std::cerr << "Diffusion aux spectateurs indisponible" << std::endl;
+    }
+    publishState(-1);
+    
     while (window. isOpen()) {
         sf::Event event;
         while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window.close();
-            }
-            
-            if (event. type == sf::Event::KeyPressed) {
-                handleKeyPress(event.key.code);
-            }
-            
-            if (event.type == sf::Event:: MouseMoved) {
-                handleMouseMove(event.mouseMove.x, event.mouseMove.y);
-            }
-            
-            if (event.type == sf::Event:: MouseButtonPressed) {
-                if (event.mouseButton.button == sf::Mouse::Left) {
-                    if (showModeSelection) {
-                        handleModeSelection(event.mouseButton.x, event.mouseButton.y);
-                    } else if (! gameOver) {
-                        handleClick(event.mouseButton.x, event.mouseButton.y);
-                    }
-                }
-            }
+            recorder.record(event);
+            handleEvent(event);
         }
         
         // Rendu
-        window.clear(sf::Color(236, 240, 241));
-        
-        if (showModeSelection) {
-            drawModeSelection();
-        } else {
-            drawScoreBoard();
-            drawGrid();
-            drawCellHighlight();
-            drawSymbols();
-            drawCurrentPlayerIndicator();
-            
-            if (hasWinningLine) {
-                drawWinningLine();
-            }
-            
-            if (gameOver) {
-                drawEndScreen();
-            }
-        }
-        
+        drawFrame(nullptr);
         window.display();
         
         // Tour de l'IA
@@ -280,8 +351,110 @@ void Game::run() {
     }
 }
 
+// Traiter un événement de la fenêtre
+void Game::handleEvent(const sf::Event& event) {
+    if (event.type == sf::Event::Closed) {
+        window.close();
+    }
+    
+    if (event. type == sf::Event::KeyPressed) {
+        handleKeyPress(event.key.code);
+    }
+    
+    if (event.type == sf::Event:: MouseMoved) {
+        handleMouseMove(event.mouseMove.x, event.mouseMove.y);
+    }
+    
+    if (event.type == sf::Event:: MouseButtonPressed) {
+        if (event.mouseButton.button == sf::Mouse::Left) {
+            if (showModeSelection) {
+                handleModeSelection(event.mouseButton.x, event.mouseButton.y);
+            } else if (! gameOver) {
+                handleClick(event.mouseButton.x, event.mouseButton.y);
+            }
+        }
+    }
+}
+
+// Dessiner une image complète, en mesurant chaque étape si timings est fourni
+void Game::drawFrame(RenderTimings* timings) {
+    auto step = [this, timings](DrawStep id, void (Game::*draw)()) {
+        if (!timings) {
+            (this->*draw)();
+            return;
+        }
+        sf::Clock stepClock;
+        (this->*draw)();
+        timings->record(id, stepClock.getElapsedTime());
+    };
+    
+    surface->clear(sf::Color(236, 240, 241));
+    
+    if (showModeSelection) {
+        step(DRAW_MODE_SELECTION, &Game::drawModeSelection);
+    } else {
+        step(DRAW_SCORE_BOARD, &Game::drawScoreBoard);
+        step(DRAW_GRID, &Game::drawGrid);
+        step(DRAW_CELL_HIGHLIGHT, &Game::drawCellHighlight);
+        step(DRAW_SYMBOLS, &Game::drawSymbols);
+        step(DRAW_CURRENT_PLAYER_INDICATOR, &Game::drawCurrentPlayerIndicator);
+        
+        if (hasWinningLine) {
+            step(DRAW_WINNING_LINE, &Game::drawWinningLine);
+        }
+        
+        if (gameOver) {
+            step(DRAW_END_SCREEN, &Game::drawEndScreen);
+        }
+    }
+}
+
 // Dessiner le highlight de la case survolée
 void Game::drawCellHighlight() {
+    if (gameMode == PLAYER_VS_AI_ULTIMATE) {
+        if (gameOver) return;
+        
+        // Sous-grilles dans lesquelles le joueur peut jouer
+        for (int sub = 0; sub < 9; sub++) {
+            if (ultimate.boardOwner(sub) != 0) continue;
+            if (ultimate.activeBoard != -1 && ultimate.activeBoard != sub) continue;
+            
+            sf::RectangleShape area(sf::Vector2f(CELL_SIZE, CELL_SIZE));
+            area.setPosition((sub % 3) * CELL_SIZE, (sub / 3) * CELL_SIZE + SCORE_AREA_HEIGHT);
+            area.setFillColor(sf::Color(241, 196, 15, 40));
+            surface->draw(area);
+        }
+        
+        if (hoveredCell != -1) {
+            int sub = hoveredCell / 9;
+            int cell = hoveredCell % 9;
+            float innerSize = CELL_SIZE / 3.0f;
+            
+            sf::RectangleShape highlight(sf::Vector2f(innerSize, innerSize));
+            highlight.setPosition(
+                (sub % 3) * CELL_SIZE + (cell % 3) * innerSize,
+                (sub / 3) * CELL_SIZE + (cell / 3) * innerSize + SCORE_AREA_HEIGHT
+            );
+            highlight.setFillColor(sf::Color(52, 152, 219, 60));
+            surface->draw(highlight);
+        }
+        return;
+    }
+    
+    if (gameMode == PLAYER_VS_AI_QUBIC) {
+        if (hoveredCell != -1 && !gameOver) {
+            sf::RectangleShape highlight(sf::Vector2f(QUBIC_CELL_SIZE, QUBIC_CELL_SIZE));
+            highlight.setPosition(getQubicCellPosition(hoveredCell));
+            highlight.setFillColor(sf::Color(52, 152, 219, 60));
+            surface->draw(highlight);
+        }
+        return;
+    }
+    
+    if (showAnalysis && !gameOver) {
+        drawAnalysisOverlay();
+    }
+    
     if (hoveredCell != -1 && ! gameOver) {
         int col = hoveredCell % 3;
         int row = hoveredCell / 3;
@@ -289,7 +462,51 @@ void Game::drawCellHighlight() {
         sf::RectangleShape highlight(sf::Vector2f(CELL_SIZE, CELL_SIZE));
         highlight.setPosition(col * CELL_SIZE, row * CELL_SIZE + SCORE_AREA_HEIGHT);
         highlight.setFillColor(sf::Color(52, 152, 219, 30));
-        window.draw(highlight);
+        surface->draw(highlight);
+    }
+}
+
+// Colorer chaque case vide selon sa valeur pour le joueur au trait (lecture du cache uniquement)
+void Game::drawAnalysisOverlay() {
+    PositionAnalysis analysis;
+    if (!analysisCache.lookup(boardMask(board, 1), boardMask(board, 2), currentPlayer, analysis)) {
+        return;
+    }
+    
+    for (int i = 0; i < 9; i++) {
+        const MoveEvaluation& move = analysis.moves[i];
+        if (move.value == -2) continue;
+        
+        int col = i % 3;
+        int row = i / 3;
+        
+        // Plus le résultat est proche, plus la teinte est marquée
+        int alpha = move.value == 0 ? 60 : std::max(50, 170 - move.distance * 15);
+        sf::Color color;
+        std::string label;
+        if (move.value > 0) {
+            color = sf::Color(46, 204, 113, alpha);
+            label = "+" + std::to_string(move.distance);
+        } else if (move.value < 0) {
+            color = sf::Color(231, 76, 60, alpha);
+            label = "-" + std::to_string(move.distance);
+        } else {
+            color = sf::Color(241, 196, 15, alpha);
+            label = "=";
+        }
+        
+        sf::RectangleShape shade(sf::Vector2f(CELL_SIZE, CELL_SIZE));
+        shade.setPosition(col * CELL_SIZE, row * CELL_SIZE + SCORE_AREA_HEIGHT);
+        shade.setFillColor(color);
+        surface->draw(shade);
+        
+        sf::Text text;
+        text.setFont(font);
+        text.setString(label);
+        text.setCharacterSize(22);
+        text.setFillColor(sf::Color(52, 73, 94));
+        text.setPosition(col * CELL_SIZE + 8, row * CELL_SIZE + SCORE_AREA_HEIGHT + 4);
+        surface->draw(text);
     }
 }
 
@@ -313,12 +530,13 @@ void Game::drawCurrentPlayerIndicator() {
     
     indicator.setPosition(10, WINDOW_SIZE + SCORE_AREA_HEIGHT - 35);
     
-    window.draw(indicator);
+    surface->draw(indicator);
 }
 
 // Afficher l'écran de sélection de mode
 void Game:: drawModeSelection() {
-    float time = animationClock.getElapsedTime().asSeconds();
+    // Animation figée hors écran pour des images reproductibles
+    float time = headless ? 0.0f : animationClock.getElapsedTime().asSeconds();
     float bounce = std::sin(time * 2) * 5;
     
     sf::Text title;
@@ -330,7 +548,7 @@ void Game:: drawModeSelection() {
     
     sf::FloatRect titleBounds = title.getLocalBounds();
     title.setPosition((WINDOW_SIZE - titleBounds.width) / 2, 40 + bounce);
-    window.draw(title);
+    surface->draw(title);
     
     sf::Text subtitle;
     subtitle.setFont(font);
@@ -340,7 +558,7 @@ void Game:: drawModeSelection() {
     
     sf::FloatRect subtitleBounds = subtitle.getLocalBounds();
     subtitle.setPosition((WINDOW_SIZE - subtitleBounds.width) / 2, 125);
-    window.draw(subtitle);
+    surface->draw(subtitle);
     
     for (size_t i = 0; i < modeButtons.size(); i++) {
         sf::RectangleShape button = modeButtons[i];
@@ -356,8 +574,8 @@ void Game:: drawModeSelection() {
             );
         }
         
-        window. draw(button);
-        window.draw(modeButtonTexts[i]);
+        surface->draw(button);
+        surface->draw(modeButtonTexts[i]);
     }
     
     sf::Text footer;
@@ -368,7 +586,7 @@ void Game:: drawModeSelection() {
     
     sf::FloatRect footerBounds = footer.getLocalBounds();
     footer.setPosition((WINDOW_SIZE - footerBounds.width) / 2, WINDOW_SIZE + SCORE_AREA_HEIGHT - 30);
-    window.draw(footer);
+    surface->draw(footer);
 }
 
 // Gérer la sélection de mode
@@ -382,11 +600,17 @@ void Game::handleModeSelection(int mouseX, int mouseY) {
             showModeSelection = false;
             
             setRandomFirstPlayer();
+            ultimate.reset(currentPlayer);
+            qubic.reset(currentPlayer);
+            loadScores();
+            publishState(-1);
             
             std::cout << "Mode sélectionné : ";
             if (gameMode == PLAYER_VS_PLAYER) std::cout << "Joueur vs Joueur";
             else if (gameMode == PLAYER_VS_AI_EASY) std::cout << "Joueur vs IA (Facile)";
-            else std::cout << "Joueur vs IA (Difficile)";
+            else if (gameMode == PLAYER_VS_AI_HARD) std::cout << "Joueur vs IA (Difficile)";
+            else if (gameMode == PLAYER_VS_AI_ULTIMATE) std::cout << "Ultime vs IA";
+            else std::cout << "Qubic 4x4x4 vs IA";
             std::cout << std::endl;
             
             break;
@@ -399,6 +623,28 @@ void Game::handleClick(int mouseX, int mouseY) {
     int cellIndex = getCellFromPosition(mouseX, mouseY);
     if (cellIndex == -1) return;
     
+    if (gameMode == PLAYER_VS_AI_ULTIMATE) {
+        if (currentPlayer != 1) return;
+        if (ultimate.isLegal(cellIndex)) {
+            std::cout << "Joueur X joue sur la case " << cellIndex << std::endl;
+            playUltimateMove(cellIndex);
+        } else {
+            std::cout << "Coup interdit!" << std::endl;
+        }
+        return;
+    }
+    
+    if (gameMode == PLAYER_VS_AI_QUBIC) {
+        if (currentPlayer != 1) return;
+        if (qubic.isLegal(cellIndex)) {
+            std::cout << "Joueur X joue sur la case " << cellIndex << std::endl;
+            playQubicMove(cellIndex);
+        } else {
+            std::cout << "Case déjà occupée!" << std::endl;
+        }
+        return;
+    }
+    
     if (board[cellIndex] == 0) {
         board[cellIndex] = currentPlayer;
         
@@ -431,6 +677,7 @@ void Game::handleClick(int mouseX, int mouseY) {
         }
         
         currentPlayer = (currentPlayer == 1) ? 2 : 1;
+        publishState(cellIndex);
     } else {
         std::cout << "Case déjà occupée!" << std:: endl;
     }
@@ -441,6 +688,15 @@ void Game::handleKeyPress(sf::Keyboard::Key key) {
     if (key == sf::Keyboard::R && gameOver) {
         resetGame();
     }
+    if (key == sf::Keyboard::A && ! showModeSelection) {
+        // Le solveur ne couvre que la grille 3x3
+        if (gameMode == PLAYER_VS_AI_ULTIMATE || gameMode == PLAYER_VS_AI_QUBIC) {
+            std::cout << "Analyse des coups indisponible dans ce mode" << std::endl;
+        } else {
+            showAnalysis = !showAnalysis;
+            std::cout << "Analyse des coups " << (showAnalysis ? "activée" : "désactivée") << std::endl;
+        }
+    }
     if (key == sf::Keyboard:: M && ! showModeSelection) {
         showModeSelection = true;
         resetGame();
@@ -454,6 +710,10 @@ void Game::aiMove() {
         aiMoveEasy();
     } else if (gameMode == PLAYER_VS_AI_HARD) {
         aiMoveHard();
+    } else if (gameMode == PLAYER_VS_AI_ULTIMATE) {
+        aiMoveUltimate();
+    } else if (gameMode == PLAYER_VS_AI_QUBIC) {
+        aiMoveQubic();
     }
 }
 
@@ -494,26 +754,13 @@ void Game::aiMoveEasy() {
         }
         
         currentPlayer = 1;
+        publishState(move);
     }
 }
 
 // IA Difficile avec son 
 void Game::aiMoveHard() {
-    int bestScore = std::numeric_limits<int>::min();
-    int bestMove = -1;
-    
-    for (int i = 0; i < 9; i++) {
-        if (board[i] == 0) {
-            board[i] = 2;
-            int score = minimax(0, false);
-            board[i] = 0;
-            
-            if (score > bestScore) {
-                bestScore = score;
-                bestMove = i;
-            }
-        }
-    }
+    int bestMove = referenceBestMove(board);
     
     if (bestMove != -1) {
         board[bestMove] = currentPlayer;
@@ -539,64 +786,99 @@ void Game::aiMoveHard() {
         }
         
         currentPlayer = 1;
+        publishState(bestMove);
     }
 }
 
-// Algorithme Minimax
-int Game::minimax(int depth, bool isMaximizing) {
-    int result = checkWinner();
+// IA du morpion ultime
+void Game::aiMoveUltimate() {
+    sf::Clock searchClock;
+    int move = ultimateBestMove(ultimate, ULTIMATE_AI_TIME_MS);
+    if (move == -1) return;
     
-    if (result == 2) return 10 - depth;
-    if (result == 1) return depth - 10;
-    if (isBoardFull()) return 0;
+    std::cout << "IA (Ultime) joue sur la case " << move
+              << " (" << searchClock.getElapsedTime().asMilliseconds() << " ms)" << std::endl;
     
-    if (isMaximizing) {
-        int bestScore = std::numeric_limits<int>::min();
-        for (int i = 0; i < 9; i++) {
-            if (board[i] == 0) {
-                board[i] = 2;
-                int score = minimax(depth + 1, false);
-                board[i] = 0;
-                bestScore = std::max(score, bestScore);
-            }
-        }
-        return bestScore;
+    playUltimateMove(move);
+}
+
+// Jouer un coup du morpion ultime
+void Game::playUltimateMove(int move) {
+    ultimate.play(move);
+    hoveredCell = -1;
+    
+    // Son de clic 
+    playClickSound();
+    
+    if (ultimate.winner == 1 || ultimate.winner == 2) {
+        winner = ultimate.winner;
+        gameOver = true;
+        hasWinningLine = ultimate.metaWinningLine(winner, winningCombo);
+        updateScore();
+        playWinSound();
+        std::cout << "Le joueur " << (winner == 1 ? "X" : "O") 
+                  << " a gagné!" << std::endl;
+    } else if (ultimate.winner == 3) {
+        gameOver = true;
+        winner = 3;
+        updateScore();
+        playDrawSound();
+        std::cout << "Match nul!" << std::endl;
+    }
+    
+    currentPlayer = ultimate.currentPlayer;
+    publishState(move);
+}
+
+// IA du Qubic
+void Game::aiMoveQubic() {
+    sf::Clock searchClock;
+    QubicSearchInfo info;
+    int move = qubicBestMove(qubic, QUBIC_AI_TIME_MS, &info, qubicNetworkLoaded ? &qubicNetwork : nullptr);
+    if (move == -1) return;
+    
+    std::cout << "IA (Qubic) joue sur la case " << move
+              << " (" << searchClock.getElapsedTime().asMilliseconds() << " ms, ";
+    if (info.forcedWin) {
+        std::cout << "gain forcé, " << info.proofNodes << " nœuds)" << std::endl;
     } else {
-        int bestScore = std::numeric_limits<int>::max();
-        for (int i = 0; i < 9; i++) {
-            if (board[i] == 0) {
-                board[i] = 1;
-                int score = minimax(depth + 1, true);
-                board[i] = 0;
-                bestScore = std::min(score, bestScore);
-            }
-        }
-        return bestScore;
+        std::cout << "profondeur " << info.searchDepth << ", " << info.nodes << " nœuds)" << std::endl;
     }
+    
+    playQubicMove(move);
 }
 
-// Vérifier s'il y a un gagnant
-int Game::checkWinner() {
-    int winningCombos[8][3] = {
-        {0, 1, 2}, {3, 4, 5}, {6, 7, 8},
-        {0, 3, 6}, {1, 4, 7}, {2, 5, 8},
-        {0, 4, 8}, {2, 4, 6}
-    };
+// Jouer un coup du Qubic
+void Game::playQubicMove(int move) {
+    qubic.play(move);
+    hoveredCell = -1;
     
-    for (int i = 0; i < 8; i++) {
-        int a = winningCombos[i][0];
-        int b = winningCombos[i][1];
-        int c = winningCombos[i][2];
-        
-        if (board[a] != 0 && board[a] == board[b] && board[b] == board[c]) {
-            winningCombo[0] = a;
-            winningCombo[1] = b;
-            winningCombo[2] = c;
-            return board[a];
-        }
+    // Son de clic 
+    playClickSound();
+    
+    if (qubic.winner == 1 || qubic.winner == 2) {
+        winner = qubic.winner;
+        gameOver = true;
+        hasWinningLine = true;
+        updateScore();
+        playWinSound();
+        std::cout << "Le joueur " << (winner == 1 ? "X" : "O") 
+                  << " a gagné!" << std::endl;
+    } else if (qubic.winner == 3) {
+        gameOver = true;
+        winner = 3;
+        updateScore();
+        playDrawSound();
+        std::cout << "Match nul!" << std::endl;
     }
     
-    return 0;
+    currentPlayer = qubic.currentPlayer;
+    publishState(move);
+}
+
+// Vérifier s'il y a un gagnant
+int Game::checkWinner() {
+    return referenceWinner(board, winningCombo);
 }
 
 // Vérifier si la grille est pleine
@@ -618,10 +900,35 @@ void Game::updateScore() {
     } else if (winner == 3) {
         scoreDraw++;
     }
+    
+    // Journalisé en arrière-plan, sans bloquer la boucle de rendu
+    stats.record(gameMode, firstPlayer, winner);
+}
+
+// Charger les scores cumulés du mode courant
+void Game::loadScores() {
+    scoreX = stats.count(gameMode, 1, 1) + stats.count(gameMode, 2, 1);
+    scoreO = stats.count(gameMode, 1, 2) + stats.count(gameMode, 2, 2);
+    scoreDraw = stats.count(gameMode, 1, 3) + stats.count(gameMode, 2, 3);
 }
 
 // Dessiner la ligne gagnante
 void Game::drawWinningLine() {
+    // Qubic : la ligne traverse les niveaux, on surligne ses quatre cases
+    if (gameMode == PLAYER_VS_AI_QUBIC) {
+        for (int cell = 0; cell < QubicBoard::CELL_COUNT; cell++) {
+            if (!(qubic.winningLine & (1ULL << cell))) continue;
+            
+            sf::RectangleShape highlight(sf::Vector2f(QUBIC_CELL_SIZE, QUBIC_CELL_SIZE));
+            highlight.setPosition(getQubicCellPosition(cell));
+            highlight.setFillColor(sf::Color(46, 204, 113, 120));
+            highlight.setOutlineThickness(2);
+            highlight.setOutlineColor(sf::Color(39, 174, 96));
+            surface->draw(highlight);
+        }
+        return;
+    }
+    
     if (winningCombo[0] == -1) return;
     
     int startIndex = winningCombo[0];
@@ -649,7 +956,7 @@ void Game::drawWinningLine() {
     winLine.setOutlineThickness(2);
     winLine.setOutlineColor(sf:: Color(39, 174, 96));
     
-    window.draw(winLine);
+    surface->draw(winLine);
 }
 
 // Dessiner le tableau des scores
@@ -657,7 +964,7 @@ void Game::drawScoreBoard() {
     sf::RectangleShape scoreBackground(sf::Vector2f(WINDOW_SIZE, SCORE_AREA_HEIGHT));
     scoreBackground.setPosition(0, 0);
     scoreBackground.setFillColor(sf:: Color(52, 73, 94));
-    window.draw(scoreBackground);
+    surface->draw(scoreBackground);
     
     sf::Text title;
     title.setFont(font);
@@ -667,7 +974,7 @@ void Game::drawScoreBoard() {
     title.setStyle(sf:: Text::Bold);
     sf::FloatRect titleBounds = title.getLocalBounds();
     title.setPosition((WINDOW_SIZE - titleBounds.width) / 2, 5);
-    window.draw(title);
+    surface->draw(title);
     
     sf::Text scoreXText;
     scoreXText. setFont(font);
@@ -678,7 +985,7 @@ void Game::drawScoreBoard() {
     scoreXText.setFillColor(getPlayerColor(1));
     scoreXText.setStyle(sf::Text::Bold);
     scoreXText.setPosition(50, 40);
-    window.draw(scoreXText);
+    surface->draw(scoreXText);
     
     sf::Text scoreDrawText;
     scoreDrawText. setFont(font);
@@ -690,7 +997,7 @@ void Game::drawScoreBoard() {
     scoreDrawText.setStyle(sf::Text::Bold);
     sf::FloatRect drawBounds = scoreDrawText.getLocalBounds();
     scoreDrawText.setPosition((WINDOW_SIZE - drawBounds.width) / 2, 40);
-    window.draw(scoreDrawText);
+    surface->draw(scoreDrawText);
     
     sf::Text scoreOText;
     scoreOText.setFont(font);
@@ -702,18 +1009,127 @@ void Game::drawScoreBoard() {
     scoreOText.setStyle(sf:: Text::Bold);
     sf::FloatRect oBounds = scoreOText.getLocalBounds();
     scoreOText.setPosition(WINDOW_SIZE - oBounds. width - 50, 40);
-    window.draw(scoreOText);
+    surface->draw(scoreOText);
 }
 
 // Dessiner la grille
 void Game::drawGrid() {
+    if (gameMode == PLAYER_VS_AI_QUBIC) {
+        for (const auto& line : qubicLines) {
+            surface->draw(line);
+        }
+        
+        for (int plane = 0; plane < 4; plane++) {
+            sf::Text label;
+            label.setFont(font);
+            label.setString("Niveau " + std::to_string(plane + 1));
+            label.setCharacterSize(14);
+            label.setFillColor(sf::Color(127, 140, 141));
+            label.setPosition(
+                (plane % 2) * QUBIC_PLANE_SIZE + QUBIC_PLANE_MARGIN,
+                (plane / 2) * QUBIC_PLANE_SIZE + SCORE_AREA_HEIGHT + 2
+            );
+            surface->draw(label);
+        }
+        return;
+    }
+    
+    if (gameMode == PLAYER_VS_AI_ULTIMATE) {
+        for (const auto& line : ultimateLines) {
+            surface->draw(line);
+        }
+    }
+    
     for (const auto& line : lines) {
-        window.draw(line);
+        surface->draw(line);
     }
 }
 
 // Dessiner les X et O
 void Game::drawSymbols() {
+    if (gameMode == PLAYER_VS_AI_ULTIMATE) {
+        float innerSize = CELL_SIZE / 3.0f;
+        
+        for (int i = 0; i < UltimateBoard::CELL_COUNT; i++) {
+            int owner = ultimate.cellOwner(i);
+            if (owner == 0) continue;
+            
+            int sub = i / 9;
+            int cell = i % 9;
+            
+            sf::Text text;
+            text.setFont(font);
+            text.setString(owner == 1 ? "X" : "O");
+            text.setCharacterSize(36);
+            text.setFillColor(getPlayerColor(owner));
+            text.setStyle(sf::Text::Bold);
+            
+            sf::FloatRect bounds = text.getLocalBounds();
+            text.setPosition(
+                (sub % 3) * CELL_SIZE + (cell % 3) * innerSize + (innerSize - bounds.width) / 2 - bounds.left,
+                (sub / 3) * CELL_SIZE + (cell / 3) * innerSize + SCORE_AREA_HEIGHT + (innerSize - bounds.height) / 2 - bounds.top
+            );
+            
+            surface->draw(text);
+        }
+        
+        // Sous-grilles terminées : voile et grand symbole
+        for (int sub = 0; sub < 9; sub++) {
+            int owner = ultimate.boardOwner(sub);
+            if (owner == 0) continue;
+            
+            int col = sub % 3;
+            int row = sub / 3;
+            
+            sf::RectangleShape veil(sf::Vector2f(CELL_SIZE, CELL_SIZE));
+            veil.setPosition(col * CELL_SIZE, row * CELL_SIZE + SCORE_AREA_HEIGHT);
+            veil.setFillColor(sf::Color(236, 240, 241, 180));
+            surface->draw(veil);
+            
+            if (owner == 3) continue;
+            
+            sf::Text text;
+            text.setFont(font);
+            text.setString(owner == 1 ? "X" : "O");
+            text.setCharacterSize(150);
+            text.setFillColor(getPlayerColor(owner));
+            text.setStyle(sf::Text::Bold);
+            
+            sf::FloatRect bounds = text.getLocalBounds();
+            text.setPosition(
+                col * CELL_SIZE + (CELL_SIZE - bounds.width) / 2 - bounds.left,
+                row * CELL_SIZE + SCORE_AREA_HEIGHT + (CELL_SIZE - bounds.height) / 2 - bounds.top
+            );
+            
+            surface->draw(text);
+        }
+        return;
+    }
+    
+    if (gameMode == PLAYER_VS_AI_QUBIC) {
+        for (int i = 0; i < QubicBoard::CELL_COUNT; i++) {
+            int owner = qubic.cellOwner(i);
+            if (owner == 0) continue;
+            
+            sf::Text text;
+            text.setFont(font);
+            text.setString(owner == 1 ? "X" : "O");
+            text.setCharacterSize(40);
+            text.setFillColor(getPlayerColor(owner));
+            text.setStyle(sf::Text::Bold);
+            
+            sf::Vector2f position = getQubicCellPosition(i);
+            sf::FloatRect bounds = text.getLocalBounds();
+            text.setPosition(
+                position.x + (QUBIC_CELL_SIZE - bounds.width) / 2 - bounds.left,
+                position.y + (QUBIC_CELL_SIZE - bounds.height) / 2 - bounds.top
+            );
+            
+            surface->draw(text);
+        }
+        return;
+    }
+    
     for (int i = 0; i < 9; i++) {
         if (board[i] != 0) {
             int col = i % 3;
@@ -732,7 +1148,7 @@ void Game::drawSymbols() {
                 row * CELL_SIZE + SCORE_AREA_HEIGHT + (CELL_SIZE - bounds.height) / 2 - bounds.top
             );
             
-            window.draw(text);
+            surface->draw(text);
         }
     }
 }
@@ -742,7 +1158,7 @@ void Game::drawEndScreen() {
     sf::RectangleShape background(sf::Vector2f(WINDOW_SIZE, 220));
     background.setPosition(0, (WINDOW_SIZE + SCORE_AREA_HEIGHT) / 2 - 110);
     background.setFillColor(sf::Color(255, 255, 255, 245));
-    window.draw(background);
+    surface->draw(background);
     
     sf::Text endText;
     endText.setFont(font);
@@ -768,7 +1184,7 @@ void Game::drawEndScreen() {
         (WINDOW_SIZE - bounds.width) / 2 - bounds.left,
         (WINDOW_SIZE + SCORE_AREA_HEIGHT) / 2 - 90
     );
-    window.draw(endText);
+    surface->draw(endText);
     
     sf::Text restartText;
     restartText.setFont(font);
@@ -781,7 +1197,7 @@ void Game::drawEndScreen() {
         (WINDOW_SIZE - bounds.width) / 2 - bounds.left,
         (WINDOW_SIZE + SCORE_AREA_HEIGHT) / 2 + 20
     );
-    window.draw(restartText);
+    surface->draw(restartText);
 }
 
 // Réinitialiser le jeu
@@ -804,6 +1220,114 @@ void Game::resetGame() {
     } else {
         setRandomFirstPlayer();
     }
+    ultimate.reset(currentPlayer);
+    qubic.reset(currentPlayer);
+    publishState(-1);
     
     std::cout << "\nNouvelle partie!\n" << std::endl;
 }
+
+// Publier l'état courant aux spectateurs
+void Game::publishState(int lastMove) {
+    SpectatorFrame frame;
+    frame.lastMove = lastMove;
+    frame.scores[0] = scoreX;
+    frame.scores[1] = scoreO;
+    frame.scores[2] = scoreDraw;
+    frame.mode = static_cast<uint8_t>(gameMode);
+    frame.showModeSelection = showModeSelection;
+    frame.currentPlayer = static_cast<uint8_t>(currentPlayer);
+    frame.winner = static_cast<uint8_t>(winner);
+    frame.gameOver = gameOver;
+    frame.hasWinningLine = hasWinningLine;
+    for (int i = 0; i < 3; i++) {
+        frame.winningCombo[i] = static_cast<int8_t>(winningCombo[i]);
+    }
+    for (int i = 0; i < 9; i++) {
+        frame.board[i] = static_cast<uint8_t>(board[i]);
+    }
+    frame.ultimate = ultimate;
+    frame.qubic = qubic;
+    
+    spectators.publish(frame);
+}
+
+// Reprendre l'état publié par la partie observée
+void Game::applySpectatorFrame(const SpectatorFrame& frame) {
+    scoreX = frame.scores[0];
+    scoreO = frame.scores[1];
+    scoreDraw = frame.scores[2];
+    gameMode = static_cast<GameMode>(frame.mode);
+    showModeSelection = frame.showModeSelection;
+    currentPlayer = frame.currentPlayer;
+    winner = frame.winner;
+    gameOver = frame.gameOver;
+    hasWinningLine = frame.hasWinningLine;
+    for (int i = 0; i < 3; i++) {
+        winningCombo[i] = frame.winningCombo[i];
+    }
+    for (int i = 0; i < 9; i++) {
+        board[i] = frame.board[i];
+    }
+    ultimate = frame.ultimate;
+    qubic = frame.qubic;
+    hoveredCell = -1;
+    hoveredButton = -1;
+}
+
+// Boucle du spectateur : mêmes fonctions de dessin, état lu dans l'anneau partagé
+void Game::runSpectator() {
+    SpectatorReader reader;
+    SpectatorFrame frame;
+    bool hasFrame = false;
+    bool stalled = false;
+    sf::Clock channelClock;
+    
+    while (window.isOpen()) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+        }
+        
+        if (!reader.isOpen()) {
+            if (reader.open(SpectatorPublisher::DEFAULT_CHANNEL)) {
+                std::cout << "Spectateur connecté à la partie" << std::endl;
+            }
+        } else if (channelClock.getElapsedTime().asMilliseconds() >= 500) {
+            // Le jeu recrée le canal à chaque lancement : suivre la nouvelle partie
+            channelClock.restart();
+            if (reader.refresh()) {
+                std::cout << "Spectateur connecté à une nouvelle partie" << std::endl;
+                stalled = false;
+            } else if (!stalled && reader.publisherStalled()) {
+                std::cerr << "La partie diffusée ne répond plus" << std::endl;
+                stalled = true;
+            }
+        }
+        
+        if (reader.readLatest(frame)) {
+            applySpectatorFrame(frame);
+            hasFrame = true;
+        }
+        
+        if (hasFrame) {
+            drawFrame(nullptr);
+        } else {
+            surface->clear(sf::Color(236, 240, 241));
+            
+            sf::Text waiting;
+            waiting.setFont(font);
+            waiting.setString("En attente d'une partie...");
+            waiting.setCharacterSize(30);
+            waiting.setFillColor(sf::Color(127, 140, 141));
+            sf::FloatRect bounds = waiting.getLocalBounds();
+            waiting.setPosition((WINDOW_SIZE - bounds.width) / 2, (WINDOW_SIZE + SCORE_AREA_HEIGHT) / 2);
+            surface->draw(waiting);
+        }
+        
+        window.display();
+        sf::sleep(sf::milliseconds(16));
+    }
+}
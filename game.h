@@ -3,17 +3,33 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <string>
 #include <vector>
+#include "board.h"
+#include "ultimate.h"
+#include "qubic.h"
+#include "stats.h"
+#include "spectator.h"
+#include "nnue.h"
+#include "move_analysis.h"
+#include "input_replay.h"
 
 enum GameMode {
     PLAYER_VS_PLAYER,
     PLAYER_VS_AI_EASY,
-    PLAYER_VS_AI_HARD
+    PLAYER_VS_AI_HARD,
+    PLAYER_VS_AI_ULTIMATE,
+    PLAYER_VS_AI_QUBIC
 };
 
+struct RenderTimings;
+
 class Game {
 private: 
     sf::RenderWindow window;
+    sf::RenderTexture offscreen;
+    sf::RenderTarget* surface;
+    bool headless;
     sf::Font font;
     
     sf::SoundBuffer clickBuffer;
@@ -32,8 +48,16 @@ private:
     int scoreX;
     int scoreO;
     int scoreDraw;
+    StatsStore stats;
+    SpectatorPublisher spectators;
+    InputRecorder recorder;
+    
+    UltimateBoard ultimate;
+    QubicBoard qubic;
+    NnueNetwork qubicNetwork;
+    bool qubicNetworkLoaded;
     
-    int winningCombo[3];
+    int winningCombo[ClassicBoard::ALIGN];
     bool hasWinningLine;
     
     GameMode gameMode;
@@ -45,21 +69,33 @@ private:
     int lastFirstPlayer;
     
     int hoveredCell;
+    
+    MoveAnalysisCache analysisCache;
+    bool showAnalysis;
     int hoveredButton;
     sf::Clock animationClock;
     
     std::vector<sf::RectangleShape> lines;
+    std::vector<sf::RectangleShape> ultimateLines;
+    std::vector<sf::RectangleShape> qubicLines;
     
     static const int WINDOW_SIZE = 600;
-    static const int CELL_SIZE = 200;
+    static const int CELL_SIZE = WINDOW_SIZE / ClassicBoard::SIZE;
     static const int LINE_THICKNESS = 3;
     static const int SCORE_AREA_HEIGHT = 80;
+    static const int MODE_BUTTON_COUNT = 5;
+    static const int ULTIMATE_AI_TIME_MS = 400;
+    static const int QUBIC_AI_TIME_MS = 400;
+    static const int QUBIC_PLANE_SIZE = 300;
+    static const int QUBIC_PLANE_MARGIN = 20;
+    static const int QUBIC_CELL_SIZE = 65;
     
     int checkWinner();
     bool isBoardFull();
     void handleClick(int mouseX, int mouseY);
     void handleKeyPress(sf:: Keyboard::Key key);
     void handleMouseMove(int mouseX, int mouseY);
+    void handleEvent(const sf::Event& event);
     
     void loadSounds();
     void playClickSound();
@@ -72,11 +108,18 @@ private:
     void aiMove();
     void aiMoveEasy();
     void aiMoveHard();
-    int minimax(int depth, bool isMaximizing);
+    void aiMoveUltimate();
+    void playUltimateMove(int move);
+    void aiMoveQubic();
+    void playQubicMove(int move);
     
     void drawModeSelection();
     void handleModeSelection(int mouseX, int mouseY);
     void createModeButtons();
+    void createModeButtonTexts();
+    
+    void drawFrame(RenderTimings* timings);
+    void setupBenchmarkScene(const std::string& scene);
     
     void drawGrid();
     void drawSymbols();
@@ -85,20 +128,38 @@ private:
     void drawWinningLine();
     void drawCurrentPlayerIndicator();
     void drawCellHighlight();
+    void drawAnalysisOverlay();
     void createGridLines();
     
     void updateScore();
+    void loadScores();
+    
+    void publishState(int lastMove);
+    void applySpectatorFrame(const SpectatorFrame& frame);
     
     int getCellFromPosition(int mouseX, int mouseY);
+    sf::Vector2f getQubicCellPosition(int cell);
     sf::Color getPlayerColor(int player);
 
 public:
-    // Constructeur
-    Game();
+    // Constructeur (headless : sans fenêtre ni son, aucun contexte OpenGL)
+    explicit Game(bool headless = false);
     
     // Méthode principale
     void run();
     
+    // Affichage d'une partie diffusée par un autre processus
+    void runSpectator();
+    
+    // Banc de rendu hors écran, avec export PNG optionnel ; false si le rendu ou une capture a échoué
+    bool runRenderBenchmark(int frames, const std::string& dumpDirectory);
+    
+    // Enregistrer les événements de la fenêtre pendant run()
+    bool recordInput(const std::string& path);
+    
+    // Rejouer un enregistrement sans écran, à vitesse maximale
+    void runInputReplay(const std::string& path, int repeat);
+    
     // Réinitialisation
     void resetGame();
 };
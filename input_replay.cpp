@@ -0,0 +1,297 @@
+#include "game.h"
+#include "input_replay.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+const char INPUT_MAGIC[8] = {'T', 'T', 'T', 'I', 'N', 'P', 'T', '1'};
+
+struct InputHeader {
+    char magic[8];
+    uint32_t seed;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(RecordedEvent) == 24, "format d'enregistrement figé");
+
+typedef std::chrono::steady_clock Clock;
+
+int64_t nanosecondsSince(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+const char* eventName(int type) {
+    switch (type) {
+        case sf::Event::Closed: return "Closed";
+        case sf::Event::Resized: return "Resized";
+        case sf::Event::KeyPressed: return "KeyPressed";
+        case sf::Event::KeyReleased: return "KeyReleased";
+        case sf::Event::MouseButtonPressed: return "MouseButtonPressed";
+        case sf::Event::MouseButtonReleased: return "MouseButtonReleased";
+        case sf::Event::MouseMoved: return "MouseMoved";
+        default: return "autre";
+    }
+}
+
+}
+
+// Convertir un événement SFML en enregistrement
+RecordedEvent RecordedEvent::fromEvent(const sf::Event& event, uint64_t timeUs) {
+    RecordedEvent recorded;
+    recorded.timeUs = timeUs;
+    recorded.type = static_cast<int32_t>(event.type);
+    recorded.data[0] = 0;
+    recorded.data[1] = 0;
+    recorded.data[2] = 0;
+
+    switch (event.type) {
+        case sf::Event::Resized:
+            recorded.data[0] = static_cast<int32_t>(event.size.width);
+            recorded.data[1] = static_cast<int32_t>(event.size.height);
+            break;
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+            recorded.data[0] = static_cast<int32_t>(event.key.code);
+            recorded.data[1] = (event.key.alt ? 1 : 0) | (event.key.control ? 2 : 0)
+                             | (event.key.shift ? 4 : 0) | (event.key.system ? 8 : 0);
+            break;
+        case sf::Event::TextEntered:
+            recorded.data[0] = static_cast<int32_t>(event.text.unicode);
+            break;
+        case sf::Event::MouseMoved:
+            recorded.data[0] = event.mouseMove.x;
+            recorded.data[1] = event.mouseMove.y;
+            break;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            recorded.data[0] = static_cast<int32_t>(event.mouseButton.button);
+            recorded.data[1] = event.mouseButton.x;
+            recorded.data[2] = event.mouseButton.y;
+            break;
+        default:
+            break;
+    }
+    return recorded;
+}
+
+// Reconstruire l'événement SFML
+sf::Event RecordedEvent::toEvent() const {
+    sf::Event event;
+    std::memset(&event, 0, sizeof(event));
+    event.type = static_cast<sf::Event::EventType>(type);
+
+    switch (event.type) {
+        case sf::Event::Resized:
+            event.size.width = static_cast<unsigned int>(data[0]);
+            event.size.height = static_cast<unsigned int>(data[1]);
+            break;
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+            event.key.code = static_cast<sf::Keyboard::Key>(data[0]);
+            event.key.alt = (data[1] & 1) != 0;
+            event.key.control = (data[1] & 2) != 0;
+            event.key.shift = (data[1] & 4) != 0;
+            event.key.system = (data[1] & 8) != 0;
+            break;
+        case sf::Event::TextEntered:
+            event.text.unicode = static_cast<sf::Uint32>(data[0]);
+            break;
+        case sf::Event::MouseMoved:
+            event.mouseMove.x = data[0];
+            event.mouseMove.y = data[1];
+            break;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            event.mouseButton.button = static_cast<sf::Mouse::Button>(data[0]);
+            event.mouseButton.x = data[1];
+            event.mouseButton.y = data[2];
+            break;
+        default:
+            break;
+    }
+    return event;
+}
+
+// Constructeur
+InputRecorder::InputRecorder() {
+}
+
+// Créer le fichier d'enregistrement
+bool InputRecorder::open(const std::string& path, uint32_t seed) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Impossible de créer " << path << std::endl;
+        return false;
+    }
+
+    InputHeader header;
+    std::memcpy(header.magic, INPUT_MAGIC, sizeof(INPUT_MAGIC));
+    header.seed = seed;
+    header.reserved = 0;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    clock.restart();
+    return static_cast<bool>(file);
+}
+
+// Enregistrement en cours
+bool InputRecorder::isOpen() const {
+    return file.is_open();
+}
+
+// Ajouter un événement
+void InputRecorder::record(const sf::Event& event) {
+    if (!file.is_open()) return;
+
+    uint64_t timeUs = static_cast<uint64_t>(clock.getElapsedTime().asMicroseconds());
+    RecordedEvent recorded = RecordedEvent::fromEvent(event, timeUs);
+    file.write(reinterpret_cast<const char*>(&recorded), sizeof(recorded));
+}
+
+// Charger un enregistrement
+bool loadInputRecording(const std::string& path, std::vector<RecordedEvent>& events, uint32_t* seed) {
+    std::ifstream file(path, std::ios::binary);
+    InputHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, INPUT_MAGIC, sizeof(INPUT_MAGIC)) != 0) {
+        std::cerr << "Enregistrement illisible : " << path << std::endl;
+        return false;
+    }
+    *seed = header.seed;
+
+    // Un enregistrement incomplet en fin de fichier (jeu interrompu) est ignoré
+    events.clear();
+    RecordedEvent recorded;
+    while (file.read(reinterpret_cast<char*>(&recorded), sizeof(recorded))) {
+        events.push_back(recorded);
+    }
+    return true;
+}
+
+// Commencer à enregistrer les événements de la fenêtre (avant run)
+bool Game::recordInput(const std::string& path) {
+    uint32_t seed = static_cast<uint32_t>(std::time(nullptr));
+    if (!recorder.open(path, seed)) return false;
+
+    // Même tirage au sort du premier joueur au rejeu
+    std::srand(seed);
+    std::cout << "Enregistrement des événements dans " << path << std::endl;
+    return true;
+}
+
+// Rejouer un enregistrement sans écran ni pause, en mesurant chaque événement
+void Game::runInputReplay(const std::string& path, int repeat) {
+    std::vector<RecordedEvent> events;
+    uint32_t seed;
+    if (!loadInputRecording(path, events, &seed)) return;
+    if (events.empty()) {
+        std::cout << "Enregistrement vide" << std::endl;
+        return;
+    }
+
+    std::vector<sf::Event> decoded;
+    decoded.reserve(events.size());
+    for (const RecordedEvent& recorded : events) {
+        decoded.push_back(recorded.toEvent());
+    }
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(decoded.size() * repeat);
+    int64_t worst = 0;
+    size_t worstIndex = 0;
+    int64_t aiTotal = 0;
+    int64_t aiWorst = 0;
+    int aiSteps = 0;
+    Clock::time_point replayStart = Clock::now();
+
+    // Les messages de la partie ne sont pas mesurés : la console est coupée pendant le rejeu
+    std::streambuf* console = std::cout.rdbuf(nullptr);
+
+    for (int r = 0; r < repeat; r++) {
+        // Même état de départ que le jeu à son lancement
+        std::srand(seed);
+        for (int i = 0; i < 9; i++) {
+            board[i] = 0;
+        }
+        for (int i = 0; i < 3; i++) {
+            winningCombo[i] = -1;
+        }
+        currentPlayer = 1;
+        gameOver = false;
+        winner = 0;
+        hasWinningLine = false;
+        scoreX = 0;
+        scoreO = 0;
+        scoreDraw = 0;
+        gameMode = PLAYER_VS_PLAYER;
+        showModeSelection = true;
+        showAnalysis = false;
+        hoveredCell = -1;
+        hoveredButton = -1;
+        firstPlayer = 1;
+        lastFirstPlayer = 0;
+        ultimate.reset(1);
+        qubic.reset(1);
+
+        for (size_t i = 0; i < decoded.size(); i++) {
+            Clock::time_point start = Clock::now();
+            handleEvent(decoded[i]);
+            int64_t elapsed = nanosecondsSince(start);
+            latencies.push_back(elapsed);
+            if (elapsed > worst) {
+                worst = elapsed;
+                worstIndex = i;
+            }
+
+            // Le tour de l'IA est joué aussitôt, sans la pause de 500 ms, et mesuré à part
+            if (!showModeSelection && !gameOver && currentPlayer == 2 && gameMode != PLAYER_VS_PLAYER) {
+                start = Clock::now();
+                aiMove();
+                elapsed = nanosecondsSince(start);
+                aiTotal += elapsed;
+                aiWorst = std::max(aiWorst, elapsed);
+                aiSteps++;
+            }
+        }
+    }
+
+    std::cout.rdbuf(console);
+    std::cout.clear();
+
+    double wallSeconds = std::chrono::duration<double>(Clock::now() - replayStart).count();
+    int64_t inputTotal = 0;
+    for (int64_t latency : latencies) inputTotal += latency;
+    std::vector<int64_t> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p) {
+        return sorted[static_cast<size_t>(p * (sorted.size() - 1))] / 1000.0;
+    };
+
+    int counts[sf::Event::Count] = {};
+    for (const sf::Event& event : decoded) {
+        if (event.type >= 0 && event.type < sf::Event::Count) counts[event.type]++;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Rejeu de " << path << " : " << decoded.size() << " événements x " << repeat
+              << " (enregistrés sur " << events.back().timeUs / 1e6 << " s)" << std::endl;
+    for (int type = 0; type < sf::Event::Count; type++) {
+        if (counts[type] == 0) continue;
+        std::cout << "    " << std::left << std::setw(22) << eventName(type) << std::right
+                  << std::setw(8) << counts[type] << std::endl;
+    }
+    std::cout << "Entrées : " << latencies.size() / (inputTotal / 1e9) << " événements/s, latence moy "
+              << inputTotal / 1000.0 / latencies.size() << " us, p50 " << percentile(0.50)
+              << " us, p99 " << percentile(0.99) << " us, max " << worst / 1000.0
+              << " us (événement " << worstIndex << ", " << eventName(decoded[worstIndex].type) << ")" << std::endl;
+    if (aiSteps > 0) {
+        std::cout << "IA : " << aiSteps << " coups, moy " << aiTotal / 1e6 / aiSteps
+                  << " ms, max " << aiWorst / 1e6 << " ms" << std::endl;
+    }
+    std::cout << "Durée totale du rejeu : " << wallSeconds << " s" << std::endl;
+}
@@ -0,0 +1,38 @@
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include <SFML/Window/Event.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Enregistrement des événements bruts de la fenêtre, rejoués sans écran par
+// Game::runInputReplay. Fichier : en-tête (magie "TTTINPT1", graine du tirage
+// au sort) puis un enregistrement de 24 octets par événement.
+struct RecordedEvent {
+    uint64_t timeUs;    // depuis le début de l'enregistrement
+    int32_t type;       // sf::Event::EventType
+    int32_t data[3];    // champs utiles selon le type (position, bouton, touche...)
+
+    static RecordedEvent fromEvent(const sf::Event& event, uint64_t timeUs);
+    sf::Event toEvent() const;
+};
+
+class InputRecorder {
+public:
+    InputRecorder();
+
+    bool open(const std::string& path, uint32_t seed);
+    bool isOpen() const;
+    void record(const sf::Event& event);
+
+private:
+    std::ofstream file;
+    sf::Clock clock;
+};
+
+// Charger un enregistrement complet ; seed reçoit la graine de la partie
+bool loadInputRecording(const std::string& path, std::vector<RecordedEvent>& events, uint32_t* seed);
+
+#endif
@@ -1,6 +1,50 @@
 #include "game.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string command = argc > 1 ? argv[1] : "";
+
+    // Banc de rendu hors écran : --bench-render [--frames N] [--dump dossier]
+    if (command == "--bench-render") {
+        int frames = 200;
+        std::string dumpDirectory;
+        for (int i = 2; i + 1 < argc; i += 2) {
+            std::string option = argv[i];
+            if (option == "--frames") frames = std::atoi(argv[i + 1]);
+            else if (option == "--dump") dumpDirectory = argv[i + 1];
+        }
+
+        Game game(true);
+        return game.runRenderBenchmark(frames, dumpDirectory) ? 0 : 1;
+    }
+
+    // Rejeu sans écran d'événements enregistrés : --replay fichier [--repeat N]
+    if (command == "--replay" && argc > 2) {
+        int repeat = 1;
+        if (argc > 4 && std::string(argv[3]) == "--repeat") repeat = std::max(1, std::atoi(argv[4]));
+
+        Game game(true);
+        game.runInputReplay(argv[2], repeat);
+        return 0;
+    }
+
+    // Partie normale dont les événements sont enregistrés : --record fichier
+    if (command == "--record" && argc > 2) {
+        Game game;
+        if (!game.recordInput(argv[2])) return 1;
+        game.run();
+        return 0;
+    }
+
+    // Spectateur d'une partie en cours sur la même machine
+    if (command == "--spectate") {
+        Game game;
+        game.runSpectator();
+        return 0;
+    }
 
-int main() {
     Game game;
     game.run();
     return 0;
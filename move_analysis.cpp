@@ -0,0 +1,117 @@
+#include "move_analysis.h"
+#include "solver.h"
+
+namespace {
+
+// Index base 3 d'une grille (0 vide, 1 X, 2 O par case)
+int positionIndex(uint16_t x, uint16_t o) {
+    int index = 0;
+    int power = 1;
+    for (int cell = 0; cell < 9; cell++) {
+        if (x & (1 << cell)) index += power;
+        else if (o & (1 << cell)) index += 2 * power;
+        power *= 3;
+    }
+    return index;
+}
+
+// Requête : masques et joueur au trait regroupés sur 32 bits
+uint32_t packRequest(uint16_t x, uint16_t o, int toMove) {
+    return static_cast<uint32_t>(x) | (static_cast<uint32_t>(o) << 9) | (static_cast<uint32_t>(toMove) << 18);
+}
+
+}
+
+// Constructeur
+MoveAnalysisCache::MoveAnalysisCache()
+    : entries(new Entry[2 * POSITION_COUNT]),
+      stopping(false) {
+    for (int i = 0; i < 2 * POSITION_COUNT; i++) {
+        entries[i].state.store(EMPTY, std::memory_order_relaxed);
+    }
+}
+
+// Destructeur : arrêter le thread de calcul
+MoveAnalysisCache::~MoveAnalysisCache() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+// Entrée du cache d'une position
+MoveAnalysisCache::Entry& MoveAnalysisCache::entry(uint16_t x, uint16_t o, int toMove) {
+    return entries[(toMove - 1) * POSITION_COUNT + positionIndex(x, o)];
+}
+
+// Lire une analyse en cache, ou la demander au thread de calcul
+bool MoveAnalysisCache::lookup(uint16_t x, uint16_t o, int toMove, PositionAnalysis& analysis) {
+    // Contrôle sans le solveur : sa table est construite par le thread de calcul
+    if ((x & o) != 0 || x > 0x1FF || o > 0x1FF || (toMove != 1 && toMove != 2)) return false;
+
+    Entry& cached = entry(x, o, toMove);
+    uint8_t state = cached.state.load(std::memory_order_acquire);
+    if (state == READY) {
+        analysis = cached.analysis;
+        return true;
+    }
+
+    uint8_t expected = EMPTY;
+    if (state == EMPTY && cached.state.compare_exchange_strong(expected, PENDING, std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!worker.joinable()) {
+            worker = std::thread(&MoveAnalysisCache::workerLoop, this);
+        }
+        requests.push_back(packRequest(x, o, toMove));
+        queueReady.notify_one();
+    }
+    return false;
+}
+
+// Thread de calcul
+void MoveAnalysisCache::workerLoop() {
+    for (;;) {
+        uint32_t request;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping || !requests.empty(); });
+            if (stopping) return;
+            request = requests.front();
+            requests.pop_front();
+        }
+        analyze(request);
+    }
+}
+
+// Évaluer chaque case vide à partir de la position résolue qui suit le coup
+void MoveAnalysisCache::analyze(uint32_t request) {
+    uint16_t x = request & 0x1FF;
+    uint16_t o = (request >> 9) & 0x1FF;
+    int toMove = static_cast<int>(request >> 18);
+
+    Entry& cached = entry(x, o, toMove);
+    PositionAnalysis& analysis = cached.analysis;
+    // Premier appel au solveur : la table complète est construite ici, hors du rendu
+    bool finished = !isValidPosition(x, o, toMove) || isTerminalPosition(x, o);
+
+    for (int cell = 0; cell < 9; cell++) {
+        uint16_t bit = 1 << cell;
+        if (finished || ((x | o) & bit)) {
+            analysis.moves[cell].value = -2;
+            analysis.moves[cell].distance = 0;
+            continue;
+        }
+
+        uint16_t nextX = toMove == 1 ? x | bit : x;
+        uint16_t nextO = toMove == 2 ? o | bit : o;
+        const SolvedPosition& reply = solvePosition(nextX, nextO, toMove == 1 ? 2 : 1);
+        analysis.moves[cell].value = static_cast<int8_t>(-reply.value);
+        analysis.moves[cell].distance = static_cast<int8_t>(reply.distance + 1);
+    }
+
+    cached.state.store(READY, std::memory_order_release);
+}
@@ -0,0 +1,57 @@
+#ifndef MOVE_ANALYSIS_H
+#define MOVE_ANALYSIS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Valeur d'un coup pour le joueur qui le joue
+struct MoveEvaluation {
+    int8_t value;       // 1 gain, 0 nul, -1 perte, -2 case occupée
+    int8_t distance;    // demi-coups jusqu'à la fin de partie, ce coup compris
+};
+
+// Analyse des neuf cases d'une position 3x3
+struct PositionAnalysis {
+    MoveEvaluation moves[9];
+};
+
+// Cache des analyses indexé par position, rempli par un thread de calcul.
+// lookup() ne calcule jamais : en cas d'absence il demande l'analyse et rend la main.
+class MoveAnalysisCache {
+public:
+    MoveAnalysisCache();
+    ~MoveAnalysisCache();
+
+    // x et o : masques 9 bits, toMove : 1 (X) ou 2 (O)
+    bool lookup(uint16_t x, uint16_t o, int toMove, PositionAnalysis& analysis);
+
+private:
+    static const int POSITION_COUNT = 19683;
+
+    enum EntryState : uint8_t { EMPTY, PENDING, READY };
+
+    struct Entry {
+        std::atomic<uint8_t> state;
+        PositionAnalysis analysis;
+    };
+
+    std::unique_ptr<Entry[]> entries;     // [joueur au trait - 1][position]
+
+    Entry& entry(uint16_t x, uint16_t o, int toMove);
+
+    std::thread worker;
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<uint32_t> requests;
+    bool stopping;
+
+    void workerLoop();
+    void analyze(uint32_t request);
+};
+
+#endif
@@ -0,0 +1,188 @@
+#include "nnue.h"
+#include <cstdio>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const char NNUE_MAGIC[8] = {'T', 'T', 'T', 'N', 'N', 'U', 'E', '1'};
+
+// Indice d'entrée d'une pierre de side en cell, vue de perspective
+inline int featureIndex(int perspective, int side, int cell) {
+    return (side == perspective ? 0 : 64) + cell;
+}
+
+// to = from + weights sur HIDDEN valeurs 16 bits
+inline void addVector(const int16_t* from, const int16_t* weights, int16_t* to) {
+#if defined(__AVX2__)
+    for (int i = 0; i < NnueNetwork::HIDDEN; i += 16) {
+        __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(from + i));
+        __m256i w = _mm256_load_si256(reinterpret_cast<const __m256i*>(weights + i));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(to + i), _mm256_add_epi16(a, w));
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < NnueNetwork::HIDDEN; i += 8) {
+        __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(from + i));
+        __m128i w = _mm_load_si128(reinterpret_cast<const __m128i*>(weights + i));
+        _mm_store_si128(reinterpret_cast<__m128i*>(to + i), _mm_add_epi16(a, w));
+    }
+#else
+    for (int i = 0; i < NnueNetwork::HIDDEN; i++) {
+        to[i] = static_cast<int16_t>(from[i] + weights[i]);
+    }
+#endif
+}
+
+// Produit scalaire de ReLU borné(values) par weights
+inline int32_t clippedDot(const int16_t* values, const int16_t* weights) {
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ceiling = _mm256_set1_epi16(NnueNetwork::ACTIVATION_MAX);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < NnueNetwork::HIDDEN; i += 16) {
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i w = _mm256_load_si256(reinterpret_cast<const __m256i*>(weights + i));
+        v = _mm256_min_epi16(_mm256_max_epi16(v, zero), ceiling);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(v, w));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+    return _mm_cvtsi128_si32(half);
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ceiling = _mm_set1_epi16(NnueNetwork::ACTIVATION_MAX);
+    __m128i sum = _mm_setzero_si128();
+    for (int i = 0; i < NnueNetwork::HIDDEN; i += 8) {
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(values + i));
+        __m128i w = _mm_load_si128(reinterpret_cast<const __m128i*>(weights + i));
+        v = _mm_min_epi16(_mm_max_epi16(v, zero), ceiling);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(v, w));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+#else
+    int32_t sum = 0;
+    for (int i = 0; i < NnueNetwork::HIDDEN; i++) {
+        int16_t v = values[i];
+        if (v < 0) v = 0;
+        if (v > NnueNetwork::ACTIVATION_MAX) v = NnueNetwork::ACTIVATION_MAX;
+        sum += v * weights[i];
+    }
+    return sum;
+#endif
+}
+
+}
+
+// Constructeur : réseau nul
+NnueNetwork::NnueNetwork()
+    : outputBias(0),
+      outputScale(64) {
+    std::memset(inputWeights, 0, sizeof(inputWeights));
+    std::memset(inputBias, 0, sizeof(inputBias));
+    std::memset(outputWeights, 0, sizeof(outputWeights));
+}
+
+// Charger les poids depuis un fichier
+// Format : magic[8], uint32 entrées, uint32 neurones, int16 poids[128][32], int16 biais[32],
+//          int16 sortie[64], int32 biais de sortie, int32 diviseur de sortie
+bool NnueNetwork::load(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    char magic[8];
+    uint32_t inputs = 0;
+    uint32_t hidden = 0;
+    bool ok = std::fread(magic, sizeof(magic), 1, file) == 1
+        && std::memcmp(magic, NNUE_MAGIC, sizeof(magic)) == 0
+        && std::fread(&inputs, sizeof(inputs), 1, file) == 1
+        && std::fread(&hidden, sizeof(hidden), 1, file) == 1
+        && inputs == INPUTS && hidden == HIDDEN
+        && std::fread(inputWeights, sizeof(inputWeights), 1, file) == 1
+        && std::fread(inputBias, sizeof(inputBias), 1, file) == 1
+        && std::fread(outputWeights, sizeof(outputWeights), 1, file) == 1
+        && std::fread(&outputBias, sizeof(outputBias), 1, file) == 1
+        && std::fread(&outputScale, sizeof(outputScale), 1, file) == 1
+        && outputScale > 0;
+
+    std::fclose(file);
+    return ok;
+}
+
+// Enregistrer les poids
+bool NnueNetwork::save(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    uint32_t inputs = INPUTS;
+    uint32_t hidden = HIDDEN;
+    bool ok = std::fwrite(NNUE_MAGIC, sizeof(NNUE_MAGIC), 1, file) == 1
+        && std::fwrite(&inputs, sizeof(inputs), 1, file) == 1
+        && std::fwrite(&hidden, sizeof(hidden), 1, file) == 1
+        && std::fwrite(inputWeights, sizeof(inputWeights), 1, file) == 1
+        && std::fwrite(inputBias, sizeof(inputBias), 1, file) == 1
+        && std::fwrite(outputWeights, sizeof(outputWeights), 1, file) == 1
+        && std::fwrite(&outputBias, sizeof(outputBias), 1, file) == 1
+        && std::fwrite(&outputScale, sizeof(outputScale), 1, file) == 1;
+
+    return std::fclose(file) == 0 && ok;
+}
+
+// Poids aléatoires (mesures de performance, point de départ d'un entraînement)
+void NnueNetwork::randomize(uint32_t seed) {
+    uint32_t state = seed ? seed : 1;
+    auto next = [&state](int range) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return static_cast<int16_t>(static_cast<int>(state % (2 * range + 1)) - range);
+    };
+
+    for (int i = 0; i < INPUTS; i++) {
+        for (int j = 0; j < HIDDEN; j++) inputWeights[i][j] = next(16);
+    }
+    for (int j = 0; j < HIDDEN; j++) inputBias[j] = next(32);
+    for (int j = 0; j < 2 * HIDDEN; j++) outputWeights[j] = next(64);
+    outputBias = 0;
+    outputScale = 64;
+}
+
+// Recalcul complet de l'accumulateur
+void NnueNetwork::refresh(Accumulator& accumulator, uint64_t x, uint64_t o) const {
+    for (int perspective = 0; perspective < 2; perspective++) {
+        std::memcpy(accumulator.values[perspective], inputBias, sizeof(inputBias));
+    }
+
+    for (int side = 0; side < 2; side++) {
+        uint64_t stones = side == 0 ? x : o;
+        while (stones) {
+            int cell = __builtin_ctzll(stones);
+            stones &= stones - 1;
+            for (int perspective = 0; perspective < 2; perspective++) {
+                int16_t* values = accumulator.values[perspective];
+                addVector(values, inputWeights[featureIndex(perspective, side, cell)], values);
+            }
+        }
+    }
+}
+
+// Mise à jour incrémentale après un coup
+void NnueNetwork::addStone(const Accumulator& from, Accumulator& to, int cell, int side) const {
+    for (int perspective = 0; perspective < 2; perspective++) {
+        addVector(from.values[perspective], inputWeights[featureIndex(perspective, side, cell)],
+                  to.values[perspective]);
+    }
+}
+
+// Évaluation du point de vue de side
+int NnueNetwork::evaluate(const Accumulator& accumulator, int side) const {
+    int32_t sum = outputBias
+        + clippedDot(accumulator.values[side], outputWeights)
+        + clippedDot(accumulator.values[1 - side], outputWeights + HIDDEN);
+    return sum / outputScale;
+}
@@ -0,0 +1,45 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <cstdint>
+#include <string>
+
+// Petit réseau quantifié pour évaluer les positions du Qubic (style NNUE).
+// Entrées : 128 indicateurs (case x pierre alliée / adverse) vus de chaque camp.
+// La première couche est tenue dans un accumulateur mis à jour à chaque coup,
+// la sortie combine les deux perspectives après un ReLU borné.
+class NnueNetwork {
+public:
+    static const int INPUTS = 128;
+    static const int HIDDEN = 32;
+    static const int ACTIVATION_MAX = 127;
+
+    // Accumulateur de la première couche, perspective de X (0) et de O (1)
+    struct alignas(32) Accumulator {
+        int16_t values[2][HIDDEN];
+    };
+
+    NnueNetwork();
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+    void randomize(uint32_t seed);
+
+    // Recalcul complet depuis les masques de X et de O
+    void refresh(Accumulator& accumulator, uint64_t x, uint64_t o) const;
+
+    // Mise à jour incrémentale : to = from + pierre de side (0 X, 1 O) en cell
+    void addStone(const Accumulator& from, Accumulator& to, int cell, int side) const;
+
+    // Score du point de vue de side, dans les unités de l'évaluation heuristique
+    int evaluate(const Accumulator& accumulator, int side) const;
+
+private:
+    alignas(32) int16_t inputWeights[INPUTS][HIDDEN];
+    alignas(32) int16_t inputBias[HIDDEN];
+    alignas(32) int16_t outputWeights[2 * HIDDEN];
+    int32_t outputBias;
+    int32_t outputScale;
+};
+
+#endif
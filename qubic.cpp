@@ -0,0 +1,504 @@
+#include "qubic.h"
+#include "nnue.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace {
+
+// Lignes gagnantes et lignes passant par chaque case
+struct LineTables {
+    uint64_t lines[QubicBoard::LINE_COUNT];
+    int cellLines[QubicBoard::CELL_COUNT][7];
+    int cellLineCount[QubicBoard::CELL_COUNT];
+    int moveOrder[QubicBoard::CELL_COUNT];
+
+    LineTables() {
+        int count = 0;
+
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    // Une seule direction par paire opposée
+                    if (dz < 0 || (dz == 0 && dy < 0) || (dz == 0 && dy == 0 && dx <= 0)) continue;
+
+                    for (int z = 0; z < 4; z++) {
+                        for (int y = 0; y < 4; y++) {
+                            for (int x = 0; x < 4; x++) {
+                                if (inside(x - dx, y - dy, z - dz)) continue;
+                                if (!inside(x + 3 * dx, y + 3 * dy, z + 3 * dz)) continue;
+
+                                uint64_t mask = 0;
+                                for (int i = 0; i < 4; i++) {
+                                    mask |= 1ULL << cellIndex(x + i * dx, y + i * dy, z + i * dz);
+                                }
+                                lines[count++] = mask;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        for (int cell = 0; cell < QubicBoard::CELL_COUNT; cell++) {
+            cellLineCount[cell] = 0;
+            for (int i = 0; i < QubicBoard::LINE_COUNT; i++) {
+                if (lines[i] & (1ULL << cell)) {
+                    cellLines[cell][cellLineCount[cell]++] = i;
+                }
+            }
+            moveOrder[cell] = cell;
+        }
+
+        // Les cases les plus connectées (coins et centre) d'abord
+        std::stable_sort(moveOrder, moveOrder + QubicBoard::CELL_COUNT, [this](int a, int b) {
+            return cellLineCount[a] > cellLineCount[b];
+        });
+    }
+
+    static bool inside(int x, int y, int z) {
+        return x >= 0 && x < 4 && y >= 0 && y < 4 && z >= 0 && z < 4;
+    }
+
+    static int cellIndex(int x, int y, int z) {
+        return z * 16 + y * 4 + x;
+    }
+};
+
+const LineTables tables;
+
+inline int lowestBit(uint64_t mask) {
+    return __builtin_ctzll(mask);
+}
+
+inline int bitCount(uint64_t mask) {
+    return __builtin_popcountll(mask);
+}
+
+inline bool isSingleBit(uint64_t mask) {
+    return mask != 0 && (mask & (mask - 1)) == 0;
+}
+
+// Cases qui complètent une ligne de trois pierres de own
+uint64_t threatCells(uint64_t own, uint64_t opp) {
+    uint64_t threats = 0;
+    for (int i = 0; i < QubicBoard::LINE_COUNT; i++) {
+        uint64_t line = tables.lines[i];
+        if (line & opp) continue;
+        uint64_t rest = line & ~own;
+        if (isSingleBit(rest)) threats |= rest;
+    }
+    return threats;
+}
+
+// Cases qui créent une menace (ligne de deux pierres de own et deux cases vides)
+uint64_t threatMakingCells(uint64_t own, uint64_t opp) {
+    uint64_t cells = 0;
+    for (int i = 0; i < QubicBoard::LINE_COUNT; i++) {
+        uint64_t line = tables.lines[i];
+        if (line & opp) continue;
+        uint64_t rest = line & ~own;
+        if (bitCount(rest) == 2) cells |= rest;
+    }
+    return cells;
+}
+
+// ---------------------------------------------------------------------------
+// Recherche proof-number restreinte aux menaces
+// ---------------------------------------------------------------------------
+
+const uint32_t PN_INFINITY = 1u << 30;
+
+enum ProofStatus { UNKNOWN, PROVEN, DISPROVEN };
+
+struct ProofNode {
+    int parent;
+    int firstChild;
+    int childCount;
+    int move;
+    bool attackerTurn;
+    uint32_t pn;
+    uint32_t dn;
+};
+
+std::vector<ProofNode>& proofPool() {
+    static std::vector<ProofNode> pool;
+    return pool;
+}
+
+// Statut d'une position : l'attaquant ne joue que des menaces,
+// le défenseur ne peut que parer
+ProofStatus proofStatus(uint64_t attacker, uint64_t defender, bool attackerTurn) {
+    if (attackerTurn) {
+        if (threatCells(attacker, defender)) return PROVEN;
+        uint64_t defenderThreats = threatCells(defender, attacker);
+        if (defenderThreats) {
+            return isSingleBit(defenderThreats) ? UNKNOWN : DISPROVEN;
+        }
+        if (threatMakingCells(attacker, defender) == 0) return DISPROVEN;
+        return UNKNOWN;
+    }
+
+    if (threatCells(defender, attacker)) return DISPROVEN;
+    uint64_t attackerThreats = threatCells(attacker, defender);
+    if (attackerThreats == 0) return DISPROVEN;
+    if (!isSingleBit(attackerThreats)) return PROVEN;
+    return UNKNOWN;
+}
+
+// Coups à examiner depuis une position non résolue
+uint64_t proofMoves(uint64_t attacker, uint64_t defender, bool attackerTurn) {
+    if (attackerTurn) {
+        uint64_t defenderThreats = threatCells(defender, attacker);
+        if (defenderThreats) return defenderThreats;
+        return threatMakingCells(attacker, defender);
+    }
+    return threatCells(attacker, defender);
+}
+
+void setProofNumbers(ProofNode& node, ProofStatus status) {
+    if (status == PROVEN) {
+        node.pn = 0;
+        node.dn = PN_INFINITY;
+    } else if (status == DISPROVEN) {
+        node.pn = PN_INFINITY;
+        node.dn = 0;
+    } else {
+        node.pn = 1;
+        node.dn = 1;
+    }
+}
+
+// Recalculer pn/dn d'un nœud développé à partir de ses enfants
+void updateProofNumbers(std::vector<ProofNode>& pool, int index) {
+    ProofNode& node = pool[index];
+    uint32_t minimum = PN_INFINITY;
+    uint32_t sum = 0;
+
+    for (int c = node.firstChild; c < node.firstChild + node.childCount; c++) {
+        uint32_t sumTerm = node.attackerTurn ? pool[c].dn : pool[c].pn;
+        uint32_t minTerm = node.attackerTurn ? pool[c].pn : pool[c].dn;
+        minimum = std::min(minimum, minTerm);
+        sum = std::min(PN_INFINITY, sum + sumTerm);
+    }
+
+    if (node.attackerTurn) {
+        node.pn = minimum;
+        node.dn = sum;
+    } else {
+        node.pn = sum;
+        node.dn = minimum;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Alpha-beta à profondeur limitée
+// ---------------------------------------------------------------------------
+
+const int WIN_SCORE = 100000;
+const int LINE_WEIGHTS[5] = {0, 1, 6, 40, 0};
+
+// Évaluation heuristique du point de vue de own
+int evaluate(uint64_t own, uint64_t opp) {
+    int score = 0;
+    for (int i = 0; i < QubicBoard::LINE_COUNT; i++) {
+        uint64_t line = tables.lines[i];
+        uint64_t mine = line & own;
+        uint64_t theirs = line & opp;
+        if (mine && theirs) continue;
+        if (mine) score += LINE_WEIGHTS[bitCount(mine)];
+        else if (theirs) score -= LINE_WEIGHTS[bitCount(theirs)];
+    }
+    return score;
+}
+
+// Les scores du réseau restent loin des scores de gain
+int clampEvaluation(int score) {
+    return std::max(-WIN_SCORE / 2, std::min(WIN_SCORE / 2, score));
+}
+
+struct AlphaBeta {
+    std::chrono::steady_clock::time_point deadline;
+    bool aborted;
+    long nodes;
+    
+    // Évaluation par réseau : un accumulateur par demi-coup depuis la racine
+    const NnueNetwork* network;
+    int rootSide;
+    NnueNetwork::Accumulator accumulators[QubicBoard::CELL_COUNT + 1];
+
+    // Coups triés : menaces d'abord, puis cases les plus connectées
+    int orderMoves(uint64_t own, uint64_t opp, int* moves) {
+        uint64_t empty = ~(own | opp);
+        uint64_t threatening = threatMakingCells(own, opp) & empty;
+        int count = 0;
+
+        for (int i = 0; i < QubicBoard::CELL_COUNT; i++) {
+            int cell = tables.moveOrder[i];
+            if (threatening & (1ULL << cell)) moves[count++] = cell;
+        }
+        for (int i = 0; i < QubicBoard::CELL_COUNT; i++) {
+            int cell = tables.moveOrder[i];
+            if ((empty & ~threatening) & (1ULL << cell)) moves[count++] = cell;
+        }
+        return count;
+    }
+
+    int search(uint64_t own, uint64_t opp, int depth, int ply, int alpha, int beta) {
+        nodes++;
+        if ((nodes & 1023) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            aborted = true;
+        }
+        if (aborted) return 0;
+
+        if ((own | opp) == ~0ULL) return 0;
+
+        if (threatCells(own, opp)) return WIN_SCORE - ply - 1;
+
+        uint64_t oppThreats = threatCells(opp, own);
+        if (oppThreats) {
+            if (!isSingleBit(oppThreats)) return -(WIN_SCORE - ply - 2);
+            // Parade forcée : pas de réduction de profondeur
+            return child(own, opp, lowestBit(oppThreats), depth, ply, alpha, beta);
+        }
+
+        if (depth <= 0) {
+            if (network) return clampEvaluation(network->evaluate(accumulators[ply], (rootSide + ply) & 1));
+            return evaluate(own, opp);
+        }
+
+        int moves[QubicBoard::CELL_COUNT];
+        int count = orderMoves(own, opp, moves);
+        int best = -WIN_SCORE;
+
+        for (int i = 0; i < count; i++) {
+            int score = child(own, opp, moves[i], depth - 1, ply, alpha, beta);
+            if (aborted) return 0;
+            if (score > best) best = score;
+            if (best > alpha) alpha = best;
+            if (alpha >= beta) break;
+        }
+        return best;
+    }
+
+    // Jouer move (accumulateur mis à jour) et chercher la position suivante
+    int child(uint64_t own, uint64_t opp, int move, int depth, int ply, int alpha, int beta) {
+        if (network) {
+            network->addStone(accumulators[ply], accumulators[ply + 1], move, (rootSide + ply) & 1);
+        }
+        return -search(opp, own | (1ULL << move), depth, ply + 1, -beta, -alpha);
+    }
+};
+
+const int PROOF_NODES = 200000;
+const int SAFETY_PROOF_NODES = 20000;
+const int SAFETY_CANDIDATES = 8;
+const int MAX_DEPTH = 12;
+
+}
+
+// Constructeur
+QubicBoard::QubicBoard() {
+    reset(1);
+}
+
+// Réinitialiser le plateau
+void QubicBoard::reset(int firstPlayer) {
+    stones[0] = 0;
+    stones[1] = 0;
+    currentPlayer = firstPlayer;
+    winner = 0;
+    winningLine = 0;
+}
+
+// Évaluation heuristique
+int qubicEvaluate(uint64_t own, uint64_t opp) {
+    return evaluate(own, opp);
+}
+
+// Masque d'une ligne gagnante
+uint64_t QubicBoard::lineMask(int index) {
+    return tables.lines[index];
+}
+
+// Jouer un coup (supposé légal)
+void QubicBoard::play(int move) {
+    int side = currentPlayer - 1;
+    stones[side] |= 1ULL << move;
+
+    for (int i = 0; i < tables.cellLineCount[move]; i++) {
+        uint64_t line = tables.lines[tables.cellLines[move][i]];
+        if ((stones[side] & line) == line) {
+            winner = currentPlayer;
+            winningLine = line;
+        }
+    }
+
+    if (winner == 0 && (stones[0] | stones[1]) == ~0ULL) {
+        winner = 3;
+    }
+
+    currentPlayer = (currentPlayer == 1) ? 2 : 1;
+}
+
+// Vérifier qu'un coup est légal
+bool QubicBoard::isLegal(int move) const {
+    if (winner != 0 || move < 0 || move >= CELL_COUNT) return false;
+    return ((stones[0] | stones[1]) & (1ULL << move)) == 0;
+}
+
+// Occupant d'une case (0 vide, 1 X, 2 O)
+int QubicBoard::cellOwner(int move) const {
+    uint64_t bit = 1ULL << move;
+    if (stones[0] & bit) return 1;
+    if (stones[1] & bit) return 2;
+    return 0;
+}
+
+// Recherche proof-number d'un gain par menaces successives
+bool qubicFindForcedWin(uint64_t attacker, uint64_t defender, int maxNodes, int* move, int* nodesUsed) {
+    std::vector<ProofNode>& pool = proofPool();
+    pool.clear();
+    pool.reserve(maxNodes + QubicBoard::CELL_COUNT);
+
+    pool.push_back({-1, -1, 0, -1, true, 1, 1});
+    setProofNumbers(pool[0], proofStatus(attacker, defender, true));
+
+    while (pool[0].pn != 0 && pool[0].dn != 0 && static_cast<int>(pool.size()) < maxNodes) {
+        // Sélection du nœud le plus prometteur
+        uint64_t att = attacker;
+        uint64_t def = defender;
+        int index = 0;
+
+        while (pool[index].firstChild != -1) {
+            const ProofNode& node = pool[index];
+            int best = node.firstChild;
+            for (int c = node.firstChild; c < node.firstChild + node.childCount; c++) {
+                if (node.attackerTurn ? pool[c].pn < pool[best].pn : pool[c].dn < pool[best].dn) {
+                    best = c;
+                }
+            }
+
+            if (node.attackerTurn) att |= 1ULL << pool[best].move;
+            else def |= 1ULL << pool[best].move;
+            index = best;
+        }
+
+        // Développement
+        bool attackerTurn = pool[index].attackerTurn;
+        uint64_t moves = proofMoves(att, def, attackerTurn);
+        int first = static_cast<int>(pool.size());
+        int count = 0;
+
+        while (moves) {
+            int cell = lowestBit(moves);
+            moves &= moves - 1;
+
+            uint64_t nextAtt = attackerTurn ? att | (1ULL << cell) : att;
+            uint64_t nextDef = attackerTurn ? def : def | (1ULL << cell);
+
+            pool.push_back({index, -1, 0, cell, !attackerTurn, 1, 1});
+            setProofNumbers(pool.back(), proofStatus(nextAtt, nextDef, !attackerTurn));
+            count++;
+        }
+
+        pool[index].firstChild = first;
+        pool[index].childCount = count;
+
+        // Mise à jour des ancêtres
+        while (index != -1) {
+            updateProofNumbers(pool, index);
+            index = pool[index].parent;
+        }
+    }
+
+    if (nodesUsed) *nodesUsed = static_cast<int>(pool.size());
+    if (pool[0].pn != 0) return false;
+
+    if (move) {
+        *move = -1;
+        for (int c = pool[0].firstChild; c < pool[0].firstChild + pool[0].childCount; c++) {
+            if (pool[c].pn == 0) {
+                *move = pool[c].move;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+// Meilleur coup : gain immédiat, parade, gain forcé, puis alpha-beta
+int qubicBestMove(const QubicBoard& board, int timeLimitMs, QubicSearchInfo* info,
+                  const NnueNetwork* network) {
+    QubicSearchInfo localInfo = {false, 0, 0, 0};
+    if (!info) info = &localInfo;
+    *info = localInfo;
+
+    if (board.winner != 0) return -1;
+
+    uint64_t own = board.stones[board.currentPlayer - 1];
+    uint64_t opp = board.stones[board.currentPlayer == 1 ? 1 : 0];
+
+    uint64_t ownThreats = threatCells(own, opp);
+    if (ownThreats) return lowestBit(ownThreats);
+
+    uint64_t oppThreats = threatCells(opp, own);
+    if (oppThreats) return lowestBit(oppThreats);
+
+    int forcedMove = -1;
+    if (qubicFindForcedWin(own, opp, PROOF_NODES, &forcedMove, &info->proofNodes) && forcedMove != -1) {
+        info->forcedWin = true;
+        return forcedMove;
+    }
+
+    AlphaBeta search;
+    search.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimitMs);
+    search.aborted = false;
+    search.nodes = 0;
+    search.network = network;
+    search.rootSide = board.currentPlayer - 1;
+    if (network) {
+        network->refresh(search.accumulators[0], board.stones[0], board.stones[1]);
+    }
+
+    int moves[QubicBoard::CELL_COUNT];
+    int scores[QubicBoard::CELL_COUNT];
+    int count = search.orderMoves(own, opp, moves);
+
+    // Approfondissement itératif, les coups étant retriés après chaque itération
+    for (int depth = 1; depth <= MAX_DEPTH; depth++) {
+        int depthScores[QubicBoard::CELL_COUNT];
+        int alpha = -WIN_SCORE - 1;
+
+        for (int i = 0; i < count && !search.aborted; i++) {
+            depthScores[i] = search.child(own, opp, moves[i], depth - 1, 0, alpha, WIN_SCORE + 1);
+            if (depthScores[i] > alpha) alpha = depthScores[i];
+        }
+        if (search.aborted) break;
+
+        int order[QubicBoard::CELL_COUNT];
+        for (int i = 0; i < count; i++) order[i] = i;
+        std::stable_sort(order, order + count, [&depthScores](int a, int b) {
+            return depthScores[a] > depthScores[b];
+        });
+
+        int sortedMoves[QubicBoard::CELL_COUNT];
+        for (int i = 0; i < count; i++) {
+            sortedMoves[i] = moves[order[i]];
+            scores[i] = depthScores[order[i]];
+        }
+        std::copy(sortedMoves, sortedMoves + count, moves);
+
+        info->searchDepth = depth;
+        if (scores[0] >= WIN_SCORE - MAX_DEPTH * 4 || scores[0] <= -WIN_SCORE + MAX_DEPTH * 4) break;
+    }
+    info->nodes = search.nodes;
+
+    // Écarter les coups qui laissent un gain forcé à l'adversaire
+    for (int i = 0; i < count && i < SAFETY_CANDIDATES; i++) {
+        if (!qubicFindForcedWin(opp, own | (1ULL << moves[i]), SAFETY_PROOF_NODES, nullptr, nullptr)) {
+            return moves[i];
+        }
+    }
+    return moves[0];
+}
@@ -0,0 +1,50 @@
+#ifndef QUBIC_H
+#define QUBIC_H
+
+#include <cstdint>
+
+class NnueNetwork;
+
+// Morpion 3D 4x4x4 (Qubic) : 64 cases, 76 lignes gagnantes.
+// Une case est codée niveau * 16 + ligne * 4 + colonne.
+class QubicBoard {
+public:
+    static const int SIZE = 4;
+    static const int CELL_COUNT = 64;
+    static const int LINE_COUNT = 76;
+
+    uint64_t stones[2];     // pierres de X (0) et de O (1)
+    int currentPlayer;      // 1 = X, 2 = O
+    int winner;             // 0 en cours, 1 = X, 2 = O, 3 = nul
+    uint64_t winningLine;   // masque de la ligne gagnante, 0 sinon
+
+    QubicBoard();
+
+    void reset(int firstPlayer);
+    void play(int move);
+
+    bool isLegal(int move) const;
+    int cellOwner(int move) const;
+
+    static uint64_t lineMask(int index);
+};
+
+// Informations sur la dernière recherche
+struct QubicSearchInfo {
+    bool forcedWin;     // gain forcé prouvé par la recherche de menaces
+    int proofNodes;     // nœuds de la recherche proof-number
+    int searchDepth;    // profondeur atteinte par l'alpha-beta
+    long nodes;         // nœuds de l'alpha-beta
+};
+
+// Gain forcé par menaces successives pour le joueur au trait (attacker)
+bool qubicFindForcedWin(uint64_t attacker, uint64_t defender, int maxNodes, int* move, int* nodesUsed);
+
+// Évaluation heuristique (lignes ouvertes) du point de vue de own
+int qubicEvaluate(uint64_t own, uint64_t opp);
+
+// Meilleur coup pour le joueur au trait ; network remplace l'heuristique aux feuilles de l'alpha-beta
+int qubicBestMove(const QubicBoard& board, int timeLimitMs, QubicSearchInfo* info,
+                  const NnueNetwork* network = nullptr);
+
+#endif
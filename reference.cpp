@@ -0,0 +1,96 @@
+#include "reference.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+bool isFull(const int board[9]) {
+    for (int i = 0; i < 9; i++) {
+        if (board[i] == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+// Vérifier s'il y a un gagnant
+int referenceWinner(const int board[9], int combo[3]) {
+    // Table écrite à la main : la référence ne dépend pas de Board<3,3>, qu'elle sert à vérifier
+    int winningCombos[8][3] = {
+        {0, 1, 2}, {3, 4, 5}, {6, 7, 8},
+        {0, 3, 6}, {1, 4, 7}, {2, 5, 8},
+        {0, 4, 8}, {2, 4, 6}
+    };
+    
+    for (int i = 0; i < 8; i++) {
+        int a = winningCombos[i][0];
+        int b = winningCombos[i][1];
+        int c = winningCombos[i][2];
+        
+        if (board[a] != 0 && board[a] == board[b] && board[b] == board[c]) {
+            combo[0] = a;
+            combo[1] = b;
+            combo[2] = c;
+            return board[a];
+        }
+    }
+    
+    return 0;
+}
+
+// Algorithme Minimax
+int referenceMinimax(int board[9], int depth, bool isMaximizing) {
+    int combo[3];
+    int result = referenceWinner(board, combo);
+    
+    if (result == 2) return 10 - depth;
+    if (result == 1) return depth - 10;
+    if (isFull(board)) return 0;
+    
+    if (isMaximizing) {
+        int bestScore = std::numeric_limits<int>::min();
+        for (int i = 0; i < 9; i++) {
+            if (board[i] == 0) {
+                board[i] = 2;
+                int score = referenceMinimax(board, depth + 1, false);
+                board[i] = 0;
+                bestScore = std::max(score, bestScore);
+            }
+        }
+        return bestScore;
+    } else {
+        int bestScore = std::numeric_limits<int>::max();
+        for (int i = 0; i < 9; i++) {
+            if (board[i] == 0) {
+                board[i] = 1;
+                int score = referenceMinimax(board, depth + 1, true);
+                board[i] = 0;
+                bestScore = std::min(score, bestScore);
+            }
+        }
+        return bestScore;
+    }
+}
+
+// Choix du coup de l'IA Difficile
+int referenceBestMove(int board[9]) {
+    int bestScore = std::numeric_limits<int>::min();
+    int bestMove = -1;
+    
+    for (int i = 0; i < 9; i++) {
+        if (board[i] == 0) {
+            board[i] = 2;
+            int score = referenceMinimax(board, 0, false);
+            board[i] = 0;
+            
+            if (score > bestScore) {
+                bestScore = score;
+                bestMove = i;
+            }
+        }
+    }
+    
+    return bestMove;
+}
@@ -0,0 +1,17 @@
+#ifndef REFERENCE_H
+#define REFERENCE_H
+
+// Moteur de référence du mode Difficile : minimax complet sans élagage.
+// Les moteurs optimisés doivent donner les mêmes valeurs et les mêmes coups
+// (voir tools/fuzz_engines.cpp). Grille au format de Game : 0 vide, 1 X, 2 O.
+
+// Gagnant de la grille (0 aucun, 1 X, 2 O) ; combo reçoit la ligne gagnante
+int referenceWinner(const int board[9], int combo[3]);
+
+// Score du point de vue de O : 10 - profondeur si O gagne, profondeur - 10 si X gagne, 0 si nul
+int referenceMinimax(int board[9], int depth, bool isMaximizing);
+
+// Coup joué par l'IA Difficile (O au trait) : premier coup de meilleur score, -1 si grille pleine
+int referenceBestMove(int board[9]);
+
+#endif
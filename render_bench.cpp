@@ -0,0 +1,169 @@
+#include "game.h"
+#include "render_bench.h"
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+// Constructeur
+RenderTimings::RenderTimings() {
+    reset();
+}
+
+// Remettre les mesures à zéro
+void RenderTimings::reset() {
+    for (int i = 0; i < DRAW_STEP_COUNT; i++) {
+        total[i] = 0;
+        minimum[i] = std::numeric_limits<sf::Int64>::max();
+        maximum[i] = 0;
+        calls[i] = 0;
+    }
+}
+
+// Enregistrer la durée d'une étape
+void RenderTimings::record(DrawStep step, sf::Time elapsed) {
+    sf::Int64 us = elapsed.asMicroseconds();
+    total[step] += us;
+    if (us < minimum[step]) minimum[step] = us;
+    if (us > maximum[step]) maximum[step] = us;
+    calls[step]++;
+}
+
+// Nom d'une étape de dessin
+const char* RenderTimings::stepName(DrawStep step) {
+    switch (step) {
+        case DRAW_MODE_SELECTION: return "drawModeSelection";
+        case DRAW_SCORE_BOARD: return "drawScoreBoard";
+        case DRAW_GRID: return "drawGrid";
+        case DRAW_CELL_HIGHLIGHT: return "drawCellHighlight";
+        case DRAW_SYMBOLS: return "drawSymbols";
+        case DRAW_CURRENT_PLAYER_INDICATOR: return "drawCurrentPlayerIndicator";
+        case DRAW_WINNING_LINE: return "drawWinningLine";
+        case DRAW_END_SCREEN: return "drawEndScreen";
+        default: return "?";
+    }
+}
+
+// Préparer un état de jeu scripté pour le banc de rendu
+void Game::setupBenchmarkScene(const std::string& scene) {
+    for (int i = 0; i < 9; i++) {
+        board[i] = 0;
+    }
+    for (int i = 0; i < 3; i++) {
+        winningCombo[i] = -1;
+    }
+
+    showModeSelection = false;
+    gameMode = PLAYER_VS_AI_HARD;
+    gameOver = false;
+    hasWinningLine = false;
+    winner = 0;
+    currentPlayer = 1;
+    hoveredCell = -1;
+    hoveredButton = -1;
+    scoreX = 3;
+    scoreO = 2;
+    scoreDraw = 1;
+    ultimate.reset(1);
+    qubic.reset(1);
+
+    if (scene == "menu") {
+        showModeSelection = true;
+        hoveredButton = 1;
+    } else if (scene == "partie") {
+        int position[9] = {1, 0, 2, 0, 1, 0, 0, 0, 2};
+        for (int i = 0; i < 9; i++) board[i] = position[i];
+        hoveredCell = 3;
+    } else if (scene == "victoire") {
+        int position[9] = {1, 2, 0, 1, 2, 0, 1, 0, 0};
+        for (int i = 0; i < 9; i++) board[i] = position[i];
+        winner = checkWinner();
+        gameOver = true;
+        hasWinningLine = true;
+    } else if (scene == "fin") {
+        int position[9] = {1, 2, 1, 1, 2, 2, 2, 1, 1};
+        for (int i = 0; i < 9; i++) board[i] = position[i];
+        winner = 3;
+        gameOver = true;
+    } else if (scene == "ultime") {
+        gameMode = PLAYER_VS_AI_ULTIMATE;
+        int moves[UltimateBoard::CELL_COUNT];
+        for (int k = 0; k < 40 && ultimate.winner == 0; k++) {
+            int count = ultimate.legalMoves(moves);
+            ultimate.play(moves[(k * 7) % count]);
+        }
+        currentPlayer = ultimate.currentPlayer;
+    } else if (scene == "qubic") {
+        gameMode = PLAYER_VS_AI_QUBIC;
+        for (int k = 0; k < 24 && qubic.winner == 0; k++) {
+            int cell = (k * 23 + 5) % QubicBoard::CELL_COUNT;
+            while (!qubic.isLegal(cell)) cell = (cell + 1) % QubicBoard::CELL_COUNT;
+            qubic.play(cell);
+        }
+        currentPlayer = qubic.currentPlayer;
+    }
+}
+
+// Banc de rendu hors écran
+bool Game::runRenderBenchmark(int frames, const std::string& dumpDirectory) {
+    // Sans contexte OpenGL utilisable, les mesures et les captures n'auraient aucun sens
+    if (!offscreen.create(WINDOW_SIZE, WINDOW_SIZE + SCORE_AREA_HEIGHT)) {
+        std::cerr << "Impossible de créer la texture de rendu hors écran (contexte OpenGL indisponible)" << std::endl;
+        return false;
+    }
+    surface = &offscreen;
+    createModeButtonTexts();
+    bool ok = true;
+
+    const char* scenes[] = {"menu", "partie", "victoire", "fin", "ultime", "qubic"};
+
+    std::cout << "Banc de rendu hors écran : " << WINDOW_SIZE << "x" << WINDOW_SIZE + SCORE_AREA_HEIGHT
+              << ", " << frames << " images par scène" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (const char* scene : scenes) {
+        setupBenchmarkScene(scene);
+
+        // Image de chauffe (chargement des glyphes)
+        drawFrame(nullptr);
+        offscreen.display();
+
+        RenderTimings timings;
+        sf::Int64 frameTotal = 0;
+        sf::Int64 frameMax = 0;
+
+        for (int f = 0; f < frames; f++) {
+            sf::Clock frameClock;
+            drawFrame(&timings);
+            offscreen.display();
+
+            sf::Int64 us = frameClock.getElapsedTime().asMicroseconds();
+            frameTotal += us;
+            if (us > frameMax) frameMax = us;
+        }
+
+        double frameMean = frames > 0 ? static_cast<double>(frameTotal) / frames : 0.0;
+        std::cout << "\n[" << scene << "] image : moy " << frameMean << " us, max " << frameMax << " us";
+        if (frameMean > 0) std::cout << " (" << 1e6 / frameMean << " img/s)";
+        std::cout << std::endl;
+
+        for (int i = 0; i < DRAW_STEP_COUNT; i++) {
+            if (timings.calls[i] == 0) continue;
+            std::cout << "    " << std::left << std::setw(28) << RenderTimings::stepName(static_cast<DrawStep>(i))
+                      << std::right << " moy " << std::setw(8)
+                      << static_cast<double>(timings.total[i]) / timings.calls[i] << " us"
+                      << "  min " << std::setw(6) << timings.minimum[i]
+                      << "  max " << std::setw(6) << timings.maximum[i] << std::endl;
+        }
+
+        if (!dumpDirectory.empty()) {
+            std::string path = dumpDirectory + "/" + scene + ".png";
+            if (offscreen.getTexture().copyToImage().saveToFile(path)) {
+                std::cout << "    capture : " << path << std::endl;
+            } else {
+                std::cerr << "Impossible d'écrire " << path << std::endl;
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
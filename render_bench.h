@@ -0,0 +1,34 @@
+#ifndef RENDER_BENCH_H
+#define RENDER_BENCH_H
+
+#include <SFML/System.hpp>
+
+// Étapes de dessin mesurées par le banc de rendu
+enum DrawStep {
+    DRAW_MODE_SELECTION,
+    DRAW_SCORE_BOARD,
+    DRAW_GRID,
+    DRAW_CELL_HIGHLIGHT,
+    DRAW_SYMBOLS,
+    DRAW_CURRENT_PLAYER_INDICATOR,
+    DRAW_WINNING_LINE,
+    DRAW_END_SCREEN,
+    DRAW_STEP_COUNT
+};
+
+// Temps CPU cumulés par étape de dessin (en microsecondes)
+struct RenderTimings {
+    sf::Int64 total[DRAW_STEP_COUNT];
+    sf::Int64 minimum[DRAW_STEP_COUNT];
+    sf::Int64 maximum[DRAW_STEP_COUNT];
+    int calls[DRAW_STEP_COUNT];
+
+    RenderTimings();
+
+    void reset();
+    void record(DrawStep step, sf::Time elapsed);
+
+    static const char* stepName(DrawStep step);
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include "solver.h"
+#include "board.h"
+
+namespace {
+
+const int POSITION_COUNT = 19683;
+
+struct SolverTables {
+    bool hasLine[512];
+    int base3[512];
+    SolvedPosition positions[2][POSITION_COUNT];
+    bool solved[2][POSITION_COUNT];
+
+    SolverTables() {
+        for (int mask = 0; mask < 512; mask++) {
+            hasLine[mask] = ClassicBoard::hasLine(static_cast<ClassicBoard::Mask>(mask));
+
+            base3[mask] = 0;
+            int power = 1;
+            for (int bit = 0; bit < 9; bit++) {
+                if (mask & (1 << bit)) base3[mask] += power;
+                power *= 3;
+            }
+        }
+
+        for (int side = 0; side < 2; side++) {
+            for (int i = 0; i < POSITION_COUNT; i++) solved[side][i] = false;
+        }
+
+        // Toutes les positions valides sont atteintes depuis les grilles partielles
+        for (int x = 0; x < 512; x++) {
+            for (int o = 0; o < 512; o++) {
+                if (x & o) continue;
+                if (hasLine[x] && hasLine[o]) continue;
+                solve(x, o, 0);
+                solve(x, o, 1);
+            }
+        }
+    }
+
+    int key(uint16_t x, uint16_t o) const {
+        return base3[x] + 2 * base3[o];
+    }
+
+    // Négamax mémoïsé : gain le plus court, perte la plus longue
+    const SolvedPosition& solve(uint16_t x, uint16_t o, int side) {
+        int index = key(x, o);
+        SolvedPosition& result = positions[side][index];
+        if (solved[side][index]) return result;
+        solved[side][index] = true;
+
+        uint16_t own = side == 0 ? x : o;
+        uint16_t opp = side == 0 ? o : x;
+        uint16_t empty = ~(x | o) & 0x1FF;
+        int emptyCount = 0;
+        for (int bit = 0; bit < 9; bit++) {
+            if (empty & (1 << bit)) emptyCount++;
+        }
+
+        result.bestMoves = 0;
+        result.distance = 0;
+        if (hasLine[opp]) {
+            result.value = -1;
+            return result;
+        }
+        if (hasLine[own]) {
+            result.value = 1;
+            return result;
+        }
+        if (empty == 0) {
+            result.value = 0;
+            return result;
+        }
+
+        int bestScore = -1000;
+        for (int cell = 0; cell < 9; cell++) {
+            if (!(empty & (1 << cell))) continue;
+
+            uint16_t nextX = side == 0 ? x | (1 << cell) : x;
+            uint16_t nextO = side == 0 ? o : o | (1 << cell);
+            const SolvedPosition& child = solve(nextX, nextO, 1 - side);
+
+            int value = -child.value;
+            int distance = child.distance + 1;
+            int score = value > 0 ? 100 - distance : (value < 0 ? distance - 100 : 0);
+
+            if (score > bestScore) {
+                bestScore = score;
+                result.value = static_cast<int8_t>(value);
+                result.distance = static_cast<int8_t>(value == 0 ? emptyCount : distance);
+                result.bestMoves = 0;
+            }
+            if (score == bestScore) {
+                result.bestMoves |= 1 << cell;
+            }
+        }
+        return result;
+    }
+};
+
+const SolverTables& tables() {
+    static SolverTables instance;
+    return instance;
+}
+
+}
+
+// Position 3x3 résolue
+const SolvedPosition& solvePosition(uint16_t x, uint16_t o, int toMove) {
+    const SolverTables& t = tables();
+    return t.positions[toMove - 1][t.key(x, o)];
+}
+
+// Vérifier qu'une position peut survenir dans une partie (l'un ou l'autre joueur commence)
+bool isValidPosition(uint16_t x, uint16_t o, int toMove) {
+    if (toMove != 1 && toMove != 2) return false;
+    if (x > 0x1FF || o > 0x1FF || (x & o)) return false;
+
+    // Une pierre d'écart au plus, et c'est alors à l'autre joueur de jouer
+    int difference = __builtin_popcount(x) - __builtin_popcount(o);
+    if (difference > 1 || difference < -1) return false;
+    if (difference == 1 && toMove != 2) return false;
+    if (difference == -1 && toMove != 1) return false;
+
+    // Seul le joueur qui vient de jouer peut avoir aligné
+    const SolverTables& t = tables();
+    if (t.hasLine[x] && toMove != 2) return false;
+    if (t.hasLine[o] && toMove != 1) return false;
+    return true;
+}
+
+// Vérifier si la partie est finie
+bool isTerminalPosition(uint16_t x, uint16_t o) {
+    const SolverTables& t = tables();
+    return t.hasLine[x] || t.hasLine[o] || (x | o) == 0x1FF;
+}
+
+// Masque des cases d'un joueur
+uint16_t boardMask(const int board[9], int player) {
+    uint16_t mask = 0;
+    for (int i = 0; i < 9; i++) {
+        if (board[i] == player) mask |= 1 << i;
+    }
+    return mask;
+}
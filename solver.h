@@ -0,0 +1,29 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstdint>
+
+// Résultat théorique d'une position 3x3 pour le joueur au trait
+struct SolvedPosition {
+    int8_t value;        // 1 gain, 0 nul, -1 perte
+    int8_t distance;     // demi-coups jusqu'à la fin de partie avec un jeu parfait
+    uint16_t bestMoves;  // masque des meilleurs coups (0 si la partie est finie)
+};
+
+// Table complète des 3^9 grilles pour chaque joueur au trait, calculée une seule fois.
+// x et o sont des masques 9 bits (bit i = case i), toMove vaut 1 (X) ou 2 (O).
+// La position doit être valide (voir isValidPosition).
+const SolvedPosition& solvePosition(uint16_t x, uint16_t o, int toMove);
+
+// Position atteignable : masques disjoints sur 9 bits, nombres de pierres cohérents avec
+// le joueur au trait (l'un ou l'autre peut commencer), ligne complète seulement pour
+// le joueur qui vient de jouer
+bool isValidPosition(uint16_t x, uint16_t o, int toMove);
+
+// Position terminée (ligne complète ou grille pleine)
+bool isTerminalPosition(uint16_t x, uint16_t o);
+
+// Masque 9 bits d'une grille au format de Game (0 vide, 1 X, 2 O)
+uint16_t boardMask(const int board[9], int player);
+
+#endif
@@ -0,0 +1,265 @@
+#include "spectator.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(std::is_trivially_copyable<SpectatorFrame>::value, "SpectatorFrame est copié octet par octet");
+static_assert(sizeof(SpectatorFrame) % sizeof(uint64_t) == 0, "SpectatorFrame est copié par mots de 64 bits");
+
+namespace {
+
+const uint32_t RING_MAGIC = 0x54545453;
+const int RING_SLOTS = 64;
+const int FRAME_WORDS = sizeof(SpectatorFrame) / sizeof(uint64_t);
+
+// Case de l'anneau : compteur de séquence impair pendant l'écriture
+struct RingSlot {
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint64_t> words[FRAME_WORDS];
+};
+
+}
+
+struct SpectatorRing {
+    std::atomic<uint32_t> magic;
+    uint32_t slotCount;
+    std::atomic<int32_t> publisherPid;  // jeu qui diffuse, 0 une fois arrêté
+    uint32_t reserved;
+    std::atomic<uint64_t> head;         // nombre de publications
+    RingSlot slots[RING_SLOTS];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "atomiques partagés entre processus");
+
+namespace {
+
+// Processus encore en vie (EPERM : il existe mais appartient à un autre utilisateur)
+bool processAlive(int32_t pid) {
+    return pid > 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+}
+
+// Segment laissé par un jeu arrêté sans l'avoir supprimé
+bool isStaleChannel(const std::string& channel) {
+    int fd = ::shm_open(channel.c_str(), O_RDONLY, 0);
+    if (fd < 0) return errno == ENOENT;
+
+    bool stale = true;
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(SpectatorRing))) {
+        void* mapping = ::mmap(nullptr, sizeof(SpectatorRing), PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            const SpectatorRing* ring = static_cast<const SpectatorRing*>(mapping);
+            stale = !processAlive(ring->publisherPid.load(std::memory_order_acquire));
+            ::munmap(mapping, sizeof(SpectatorRing));
+        }
+    }
+    ::close(fd);
+    return stale;
+}
+
+// Inode du segment actuellement associé au canal, 0 s'il n'existe plus
+ino_t channelInode(const std::string& channel) {
+    int fd = ::shm_open(channel.c_str(), O_RDONLY, 0);
+    if (fd < 0) return 0;
+
+    struct stat info;
+    ino_t inode = ::fstat(fd, &info) == 0 ? info.st_ino : 0;
+    ::close(fd);
+    return inode;
+}
+
+}
+
+// Constructeur
+SpectatorPublisher::SpectatorPublisher()
+    : ring(nullptr),
+      inode(0),
+      published(0) {
+}
+
+// Destructeur : le segment disparaît, les spectateurs gardent leur projection
+SpectatorPublisher::~SpectatorPublisher() {
+    if (ring) {
+        ring->publisherPid.store(0, std::memory_order_release);
+        ::munmap(ring, sizeof(SpectatorRing));
+
+        // Ne supprimer le canal que s'il désigne encore notre segment
+        if (channelInode(channel) == inode) {
+            ::shm_unlink(channel.c_str());
+        }
+    }
+}
+
+// Créer le segment partagé ; échoue si un autre jeu en cours diffuse déjà sur ce canal
+bool SpectatorPublisher::open(const std::string& name) {
+    channel = name;
+    int fd = ::shm_open(channel.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST && isStaleChannel(channel)) {
+        ::shm_unlink(channel.c_str());
+        fd = ::shm_open(channel.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (::ftruncate(fd, sizeof(SpectatorRing)) != 0 || ::fstat(fd, &info) != 0) {
+        ::close(fd);
+        ::shm_unlink(channel.c_str());
+        return false;
+    }
+
+    void* mapping = ::mmap(nullptr, sizeof(SpectatorRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        ::shm_unlink(channel.c_str());
+        return false;
+    }
+
+    // Segment neuf, mis à zéro par ftruncate
+    inode = info.st_ino;
+    ring = static_cast<SpectatorRing*>(mapping);
+    ring->slotCount = RING_SLOTS;
+    ring->publisherPid.store(static_cast<int32_t>(::getpid()), std::memory_order_relaxed);
+    ring->magic.store(RING_MAGIC, std::memory_order_release);
+    return true;
+}
+
+// Publier un état : écriture seqlock dans la case suivante
+void SpectatorPublisher::publish(SpectatorFrame& frame) {
+    if (!ring) return;
+
+    frame.sequence = published;
+    uint64_t words[FRAME_WORDS];
+    std::memcpy(words, &frame, sizeof(frame));
+
+    RingSlot& slot = ring->slots[published % RING_SLOTS];
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (int i = 0; i < FRAME_WORDS; i++) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    published++;
+    ring->head.store(published, std::memory_order_release);
+}
+
+// Constructeur
+SpectatorReader::SpectatorReader()
+    : ring(nullptr),
+      inode(0) {
+}
+
+// Destructeur
+SpectatorReader::~SpectatorReader() {
+    if (ring) {
+        ::munmap(ring, sizeof(SpectatorRing));
+    }
+}
+
+// Ouvrir le segment en lecture seule
+bool SpectatorReader::open(const std::string& name) {
+    channel = name;
+    int fd = ::shm_open(channel.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SpectatorRing))) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = ::mmap(nullptr, sizeof(SpectatorRing), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    SpectatorRing* candidate = static_cast<SpectatorRing*>(mapping);
+    if (candidate->magic.load(std::memory_order_acquire) != RING_MAGIC || candidate->slotCount != RING_SLOTS) {
+        ::munmap(mapping, sizeof(SpectatorRing));
+        return false;
+    }
+
+    if (ring) {
+        ::munmap(ring, sizeof(SpectatorRing));
+    }
+    ring = candidate;
+    inode = info.st_ino;
+    return true;
+}
+
+// Rouvrir le canal s'il désigne un nouveau segment (partie suivante)
+bool SpectatorReader::refresh() {
+    if (channel.empty()) return false;
+
+    ino_t current = channelInode(channel);
+    if (current == 0 || current == inode) return false;
+    return open(channel);
+}
+
+// Le jeu qui remplissait le segment projeté est arrêté
+bool SpectatorReader::publisherStalled() const {
+    return ring && !processAlive(ring->publisherPid.load(std::memory_order_acquire));
+}
+
+// Segment ouvert
+bool SpectatorReader::isOpen() const {
+    return ring != nullptr;
+}
+
+// Lire une case, échoue si elle est en cours d'écriture ou déjà réutilisée
+bool SpectatorReader::readSlot(uint64_t sequence, SpectatorFrame& frame) {
+    const RingSlot& slot = ring->slots[sequence % RING_SLOTS];
+    uint64_t words[FRAME_WORDS];
+
+    uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before & 1) return false;
+
+    for (int i = 0; i < FRAME_WORDS; i++) {
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != before) return false;
+
+    std::memcpy(&frame, words, sizeof(frame));
+    return frame.sequence == sequence;
+}
+
+// Dernier état publié
+bool SpectatorReader::readLatest(SpectatorFrame& frame) {
+    if (!ring) return false;
+
+    // La case head - 1 est complète avant que head n'avance : un échec signifie seulement
+    // que l'écrivain a fait un tour d'anneau pendant la lecture
+    for (;;) {
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        if (head == 0) return false;
+        if (readSlot(head - 1, frame)) return true;
+    }
+}
+
+// État suivant le curseur
+bool SpectatorReader::readNext(uint64_t& cursor, SpectatorFrame& frame) {
+    if (!ring) return false;
+
+    for (;;) {
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        if (cursor >= head) return false;
+        if (head - cursor > RING_SLOTS) {
+            cursor = head - RING_SLOTS;
+        }
+        if (readSlot(cursor, frame)) {
+            cursor++;
+            return true;
+        }
+        // Case écrasée pendant la lecture : l'écrivain est passé devant
+        cursor++;
+    }
+}
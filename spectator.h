@@ -0,0 +1,78 @@
+#ifndef SPECTATOR_H
+#define SPECTATOR_H
+
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include "ultimate.h"
+#include "qubic.h"
+
+// État complet d'une partie, publié après chaque coup
+struct SpectatorFrame {
+    uint64_t sequence;      // numéro de publication (croissant)
+    int32_t lastMove;       // -1 pour un changement d'état sans coup
+    int32_t scores[3];      // X, O, nuls
+    uint8_t mode;
+    uint8_t showModeSelection;
+    uint8_t currentPlayer;
+    uint8_t winner;
+    uint8_t gameOver;
+    uint8_t hasWinningLine;
+    int8_t winningCombo[3];
+    uint8_t board[9];
+    UltimateBoard ultimate;
+    QubicBoard qubic;
+};
+
+// Anneau en mémoire partagée : un seul écrivain, un nombre quelconque de lecteurs.
+// Chaque case est protégée par un seqlock, les lecteurs ne prennent aucun verrou.
+struct SpectatorRing;
+
+class SpectatorPublisher {
+public:
+    static constexpr const char* DEFAULT_CHANNEL = "/tic-tac-toe-spectateurs";
+
+    SpectatorPublisher();
+    ~SpectatorPublisher();
+
+    bool open(const std::string& channel);
+
+    // Coût constant quel que soit le nombre de spectateurs
+    void publish(SpectatorFrame& frame);
+
+private:
+    std::string channel;
+    SpectatorRing* ring;
+    ino_t inode;
+    uint64_t published;
+};
+
+class SpectatorReader {
+public:
+    SpectatorReader();
+    ~SpectatorReader();
+
+    bool open(const std::string& channel);
+    bool isOpen() const;
+
+    // Passer au segment d'une nouvelle partie si le canal a été recréé ; true si rouvert
+    bool refresh();
+
+    // Le jeu qui diffusait sur le segment projeté est arrêté
+    bool publisherStalled() const;
+
+    // Dernier état publié
+    bool readLatest(SpectatorFrame& frame);
+
+    // État suivant cursor (pour un enregistreur) ; saute en avant si l'écrivain a pris un tour d'avance
+    bool readNext(uint64_t& cursor, SpectatorFrame& frame);
+
+private:
+    std::string channel;
+    SpectatorRing* ring;
+    ino_t inode;
+
+    bool readSlot(uint64_t sequence, SpectatorFrame& frame);
+};
+
+#endif
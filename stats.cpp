@@ -0,0 +1,309 @@
+#include "stats.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'T', 'T', 'T', 'S', 'N', 'A', 'P', '1'};
+const char LOG_MAGIC[8] = {'T', 'T', 'T', 'L', 'O', 'G', '0', '1'};
+const uint8_t RECORD_MAGIC = 0xA7;
+
+// Instantané de taille fixe : le chargement ne dépend pas de l'historique
+struct SnapshotFile {
+    char magic[8];
+    uint64_t generation;
+    StatsStore::Counters counters;
+    uint64_t checksum;
+};
+
+// En-tête du journal : génération de l'instantané qu'il complète
+struct LogHeader {
+    char magic[8];
+    uint64_t generation;
+};
+
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 1469598103934665603ULL) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool readAll(int fd, void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t got = ::read(fd, bytes, size);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        bytes += got;
+        size -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+// Synchroniser le dossier pour rendre un renommage durable
+void syncDirectory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+
+// Écrire un fichier complet via un fichier temporaire et un renommage atomique
+bool writeFileAtomically(const std::string& path, const void* data, size_t size) {
+    std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    bool ok = writeAll(fd, data, size) && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!ok || ::rename(temporary.c_str(), path.c_str()) != 0) {
+        ::unlink(temporary.c_str());
+        return false;
+    }
+
+    syncDirectory(path);
+    return true;
+}
+
+}
+
+// Constructeur
+StatsStore::StatsStore()
+    : logFd(-1),
+      generation(0),
+      logRecords(0),
+      stopping(false) {
+    std::memset(&counters, 0, sizeof(counters));
+    std::memset(&persisted, 0, sizeof(persisted));
+}
+
+// Destructeur : vider la file puis arrêter le thread d'écriture
+StatsStore::~StatsStore() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+    if (logFd >= 0) {
+        ::close(logFd);
+    }
+}
+
+// Charger l'instantané et le journal, puis démarrer le thread d'écriture
+bool StatsStore::open(const std::string& path) {
+    snapshotPath = path + ".snapshot";
+    logPath = path + ".log";
+
+    loadSnapshot();
+    replayLog();
+    persisted = counters;
+
+    if (logFd < 0 && !startLog()) {
+        std::cerr << "Impossible d'ouvrir " << logPath << std::endl;
+        return false;
+    }
+
+    writer = std::thread(&StatsStore::writerLoop, this);
+    return true;
+}
+
+// Projeter l'instantané en mémoire et copier les compteurs
+bool StatsStore::loadSnapshot() {
+    int fd = ::open(snapshotPath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size != static_cast<off_t>(sizeof(SnapshotFile))) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapping = ::mmap(nullptr, sizeof(SnapshotFile), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    const SnapshotFile* snapshot = static_cast<const SnapshotFile*>(mapping);
+    bool valid = std::memcmp(snapshot->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0
+        && snapshot->checksum == fnv1a(snapshot, offsetof(SnapshotFile, checksum));
+
+    if (valid) {
+        generation = snapshot->generation;
+        counters = snapshot->counters;
+    } else {
+        std::cerr << "Instantané de statistiques corrompu, ignoré" << std::endl;
+    }
+
+    ::munmap(mapping, sizeof(SnapshotFile));
+    return valid;
+}
+
+// Rejouer les parties du journal postérieures à l'instantané
+void StatsStore::replayLog() {
+    int fd = ::open(logPath.c_str(), O_RDWR);
+    if (fd < 0) return;
+
+    LogHeader header;
+    if (!readAll(fd, &header, sizeof(header))
+        || std::memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0
+        || header.generation != generation) {
+        // Journal déjà intégré à l'instantané (ou illisible) : on en recrée un
+        ::close(fd);
+        return;
+    }
+
+    LogRecord record;
+    logRecords = 0;
+    while (readAll(fd, &record, sizeof(record))
+           && record.checksum == checksum(record, generation)
+           && apply(counters, record)) {
+        logRecords++;
+    }
+
+    // Couper un éventuel enregistrement incomplet laissé par un crash
+    off_t validLength = static_cast<off_t>(sizeof(LogHeader) + logRecords * sizeof(LogRecord));
+    bool truncated = ::ftruncate(fd, validLength) == 0;
+    ::close(fd);
+    if (!truncated) return;
+
+    logFd = ::open(logPath.c_str(), O_WRONLY | O_APPEND);
+}
+
+// Créer un journal vide pour la génération courante
+bool StatsStore::startLog() {
+    LogHeader header;
+    std::memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+    header.generation = generation;
+
+    if (!writeFileAtomically(logPath, &header, sizeof(header))) return false;
+
+    if (logFd >= 0) {
+        ::close(logFd);
+    }
+    logFd = ::open(logPath.c_str(), O_WRONLY | O_APPEND);
+    logRecords = 0;
+    return logFd >= 0;
+}
+
+// Enregistrer une partie
+void StatsStore::record(int mode, int firstPlayer, int winner) {
+    LogRecord record;
+    record.magic = RECORD_MAGIC;
+    record.mode = static_cast<uint8_t>(mode);
+    record.firstPlayer = static_cast<uint8_t>(firstPlayer);
+    record.winner = static_cast<uint8_t>(winner);
+    record.checksum = 0;
+
+    if (!apply(counters, record)) return;
+    if (!writer.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(record);
+    }
+    queueReady.notify_one();
+}
+
+// Nombre de parties pour un mode, un premier joueur et un résultat
+int StatsStore::count(int mode, int firstPlayer, int winner) const {
+    if (mode < 0 || mode >= MAX_MODES) return 0;
+    if (firstPlayer < 1 || firstPlayer > 2 || winner < 1 || winner > 3) return 0;
+    return static_cast<int>(counters.games[mode][firstPlayer - 1][winner - 1]);
+}
+
+// Thread d'écriture : journalisation puis compaction
+void StatsStore::writerLoop() {
+    if (logRecords >= COMPACT_EVERY) {
+        compact();
+    }
+
+    for (;;) {
+        LogRecord record;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            record = queue.front();
+            queue.pop_front();
+        }
+
+        appendRecord(record);
+
+        if (logRecords >= COMPACT_EVERY) {
+            compact();
+        }
+    }
+}
+
+// Ajouter une partie au journal et la rendre durable
+void StatsStore::appendRecord(const LogRecord& record) {
+    LogRecord stamped = record;
+    stamped.checksum = checksum(stamped, generation);
+
+    if (logFd >= 0 && writeAll(logFd, &stamped, sizeof(stamped))) {
+        ::fdatasync(logFd);
+    }
+
+    apply(persisted, stamped);
+    logRecords++;
+}
+
+// Intégrer le journal dans un nouvel instantané puis repartir d'un journal vide
+void StatsStore::compact() {
+    SnapshotFile snapshot;
+    std::memcpy(snapshot.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    snapshot.generation = generation + 1;
+    snapshot.counters = persisted;
+    snapshot.checksum = fnv1a(&snapshot, offsetof(SnapshotFile, checksum));
+
+    // Un crash entre les deux renommages laisse un journal d'ancienne génération, ignoré au chargement
+    if (!writeFileAtomically(snapshotPath, &snapshot, sizeof(snapshot))) return;
+    generation++;
+    startLog();
+}
+
+// Appliquer un enregistrement aux compteurs
+bool StatsStore::apply(Counters& target, const LogRecord& record) {
+    if (record.magic != RECORD_MAGIC) return false;
+    if (record.mode >= MAX_MODES) return false;
+    if (record.firstPlayer < 1 || record.firstPlayer > 2) return false;
+    if (record.winner < 1 || record.winner > 3) return false;
+
+    target.games[record.mode][record.firstPlayer - 1][record.winner - 1]++;
+    return true;
+}
+
+// Somme de contrôle d'un enregistrement, liée à la génération du journal
+uint32_t StatsStore::checksum(const LogRecord& record, uint64_t logGeneration) {
+    uint64_t hash = fnv1a(&record, offsetof(LogRecord, checksum));
+    hash = fnv1a(&logGeneration, sizeof(logGeneration), hash);
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
@@ -0,0 +1,71 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Statistiques persistantes par mode de jeu et par premier joueur.
+// Chaque partie est ajoutée à un journal (append-only, fdatasync par partie)
+// par un thread d'écriture ; le journal est régulièrement compacté dans un
+// instantané de taille fixe, projeté en mémoire au démarrage.
+class StatsStore {
+public:
+    static const int MAX_MODES = 8;
+    static const int COMPACT_EVERY = 64;
+
+    // Compteurs [mode][premier joueur - 1][résultat - 1] (1 X, 2 O, 3 nul)
+    struct Counters {
+        uint32_t games[MAX_MODES][2][3];
+    };
+
+    StatsStore();
+    ~StatsStore();
+
+    // Charger puis journaliser dans path.snapshot et path.log
+    bool open(const std::string& path);
+
+    // Enregistrer une partie (ne bloque pas)
+    void record(int mode, int firstPlayer, int winner);
+
+    int count(int mode, int firstPlayer, int winner) const;
+
+private:
+    struct LogRecord {
+        uint8_t magic;
+        uint8_t mode;
+        uint8_t firstPlayer;
+        uint8_t winner;
+        uint32_t checksum;
+    };
+
+    std::string snapshotPath;
+    std::string logPath;
+    int logFd;
+    uint64_t generation;
+    int logRecords;
+
+    Counters counters;      // vue du thread principal
+    Counters persisted;     // vue du thread d'écriture
+
+    std::thread writer;
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<LogRecord> queue;
+    bool stopping;
+
+    bool loadSnapshot();
+    void replayLog();
+    bool startLog();
+    void writerLoop();
+    void appendRecord(const LogRecord& record);
+    void compact();
+
+    static bool apply(Counters& target, const LogRecord& record);
+    static uint32_t checksum(const LogRecord& record, uint64_t logGeneration);
+};
+
+#endif
@@ -0,0 +1,140 @@
+// Banc des règles de grille : Board<N,K> (tables constexpr, code déroulé)
+// contre RuntimeBoard (mêmes tables, dimensions connues à l'exécution).
+//   bench_board [tours]
+//
+// Pour chaque taille : test de victoire complet, test après un coup
+// (lignes passant par la case jouée) et clé canonique par symétrie.
+
+#include "../board.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Positions aléatoires : environ 40 % de cases occupées, X et O disjoints
+struct Sample {
+    uint64_t x;
+    uint64_t o;
+    int cell;
+};
+
+std::vector<Sample> randomSamples(int cellCount, int count, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::vector<Sample> samples(count);
+    for (Sample& sample : samples) {
+        sample.x = 0;
+        sample.o = 0;
+        for (int cell = 0; cell < cellCount; cell++) {
+            int roll = static_cast<int>(random() % 10);
+            if (roll < 2) sample.x |= uint64_t(1) << cell;
+            else if (roll < 4) sample.o |= uint64_t(1) << cell;
+        }
+        sample.cell = static_cast<int>(random() % cellCount);
+    }
+    return samples;
+}
+
+volatile uint64_t sink;
+
+template <int N, int K>
+void benchSize(int rounds) {
+    typedef Board<N, K> Specialized;
+    typedef typename Specialized::Mask Mask;
+    const int SAMPLES = 4096;
+
+    RuntimeBoard generic(N, K);
+    std::vector<Sample> samples = randomSamples(N * N, SAMPLES, 1000 + N * 10 + K);
+    double operations = SAMPLES * static_cast<double>(rounds);
+
+    // Les deux chemins doivent donner les mêmes réponses
+    int mismatches = 0;
+    for (const Sample& s : samples) {
+        if (Specialized::hasLine(static_cast<Mask>(s.x)) != generic.hasLine(s.x)) mismatches++;
+        if (Specialized::hasLineThrough(static_cast<Mask>(s.x), s.cell) != generic.hasLineThrough(s.x, s.cell)) mismatches++;
+        if constexpr (N * N <= 32) {
+            if (Specialized::canonicalKey(static_cast<Mask>(s.x), static_cast<Mask>(s.o))
+                != generic.canonicalKey(s.x, s.o)) mismatches++;
+        }
+    }
+
+    uint64_t checksum = 0;
+    double rates[3][2];
+
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const Sample& s : samples) checksum += Specialized::winner(static_cast<Mask>(s.x), static_cast<Mask>(s.o));
+    }
+    rates[0][0] = operations / secondsSince(start);
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const Sample& s : samples) checksum += generic.hasLine(s.x) ? 1 : (generic.hasLine(s.o) ? 2 : 0);
+    }
+    rates[0][1] = operations / secondsSince(start);
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const Sample& s : samples) checksum += Specialized::hasLineThrough(static_cast<Mask>(s.x), s.cell);
+    }
+    rates[1][0] = operations / secondsSince(start);
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const Sample& s : samples) checksum += generic.hasLineThrough(s.x, s.cell);
+    }
+    rates[1][1] = operations / secondsSince(start);
+
+    // La clé canonique tient sur 64 bits jusqu'à 5x5
+    const bool canonical = N * N <= 32;
+    if constexpr (canonical) {
+        start = Clock::now();
+        for (int r = 0; r < rounds; r++) {
+            for (const Sample& s : samples) checksum += Specialized::canonicalKey(static_cast<Mask>(s.x), static_cast<Mask>(s.o));
+        }
+        rates[2][0] = operations / secondsSince(start);
+
+        start = Clock::now();
+        for (int r = 0; r < rounds; r++) {
+            for (const Sample& s : samples) checksum += generic.canonicalKey(s.x, s.o);
+        }
+        rates[2][1] = operations / secondsSince(start);
+    }
+    sink = checksum;
+
+    const char* names[3] = {"victoire", "après un coup", "clé canonique"};
+    std::printf("%dx%d, %d alignés (%d lignes, %d max par case) :\n",
+                N, N, K, Specialized::LINE_COUNT, Specialized::MAX_CELL_LINES);
+    for (int i = 0; i < (canonical ? 3 : 2); i++) {
+        std::printf("  %-16s spécialisé %8.1f M/s   générique %8.1f M/s   x%.2f\n",
+                    names[i], rates[i][0] / 1e6, rates[i][1] / 1e6, rates[i][0] / rates[i][1]);
+    }
+    if (mismatches != 0) {
+        std::printf("  ÉCARTS spécialisé/générique : %d\n", mismatches);
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 500;
+    if (rounds <= 0) {
+        std::fprintf(stderr, "Usage : bench_board [tours]\n");
+        return 1;
+    }
+
+    benchSize<3, 3>(rounds);
+    benchSize<4, 4>(rounds);
+    benchSize<5, 4>(rounds);
+    benchSize<5, 5>(rounds);
+    benchSize<7, 4>(rounds);
+    return 0;
+}
@@ -0,0 +1,369 @@
+// Comparaison différentielle des moteurs 3x3 avec le minimax de référence :
+//   fuzz_engines [positions] [graine]
+//
+// Sur des positions atteignables tirées au hasard, vérifie que le solveur (table),
+// l'API C par lots et Board<3,3> donnent le même gagnant, la même valeur, la même
+// distance et le même ensemble de meilleurs coups que le minimax d'origine, et que le
+// coup de l'IA Difficile fait partie de ces meilleurs coups. Vérifie aussi, sur toutes
+// les grilles et sur des entrées malformées, que seules les positions atteignables sont
+// acceptées. Affiche ensuite la distribution des accélérations par position.
+// Code de retour 1 en cas d'écart.
+
+#include "../analysis.h"
+#include "../board.h"
+#include "../reference.h"
+#include "../solver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Durée moyenne d'un appel, répété jusqu'à dépasser la résolution de l'horloge
+template <typename Function>
+double secondsPerCall(Function function) {
+    long calls = 1;
+    for (;;) {
+        Clock::time_point start = Clock::now();
+        for (long i = 0; i < calls; i++) function();
+        double elapsed = secondsSince(start);
+        if (elapsed >= 50e-6) return elapsed / calls;
+        calls *= 2;
+    }
+}
+
+struct Position {
+    int board[9];
+    int toMove;
+};
+
+// Parties aléatoires depuis la grille vide, arrêtées à un nombre de coups tiré au hasard
+std::vector<Position> randomPositions(int count, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::vector<Position> positions(count);
+
+    for (Position& position : positions) {
+        int combo[3];
+        std::fill(position.board, position.board + 9, 0);
+        position.toMove = 1 + static_cast<int>(random() % 2);
+
+        int plies = static_cast<int>(random() % 10);
+        for (int k = 0; k < plies && referenceWinner(position.board, combo) == 0; k++) {
+            int cell;
+            do cell = static_cast<int>(random() % 9); while (position.board[cell] != 0);
+            position.board[cell] = position.toMove;
+            position.toMove = position.toMove == 1 ? 2 : 1;
+        }
+    }
+    return positions;
+}
+
+std::string describe(const Position& position) {
+    std::string text;
+    for (int i = 0; i < 9; i++) {
+        text += ".XO"[position.board[i]];
+        if (i % 3 == 2 && i < 8) text += '/';
+    }
+    text += position.toMove == 1 ? " (X au trait)" : " (O au trait)";
+    return text;
+}
+
+// Résultat attendu, calculé par le minimax de référence
+struct Expected {
+    bool terminal;
+    int winner;
+    int value;
+    int distance;
+    uint16_t bestMoves;
+};
+
+Expected referenceAnalysis(const Position& position) {
+    Expected expected;
+    int board[9];
+    int combo[3];
+    std::copy(position.board, position.board + 9, board);
+
+    expected.winner = referenceWinner(board, combo);
+    expected.terminal = expected.winner != 0 || std::find(board, board + 9, 0) == board + 9;
+    expected.value = 0;
+    expected.distance = 0;
+    expected.bestMoves = 0;
+    if (expected.terminal) return expected;
+
+    // Le score de référence est du point de vue de O et pénalise la profondeur
+    bool maximizing = position.toMove == 2;
+    int score = referenceMinimax(board, 0, maximizing);
+    int sign = score > 0 ? 1 : (score < 0 ? -1 : 0);
+    expected.value = maximizing ? sign : -sign;
+    expected.distance = score == 0 ? 0 : 10 - std::abs(score);
+
+    for (int cell = 0; cell < 9; cell++) {
+        if (board[cell] != 0) continue;
+        board[cell] = position.toMove;
+        if (referenceMinimax(board, 1, !maximizing) == score) expected.bestMoves |= 1 << cell;
+        board[cell] = 0;
+    }
+    return expected;
+}
+
+std::string mismatch(const char* what, int expected, int actual) {
+    return std::string(what) + " attendu " + std::to_string(expected) + ", obtenu " + std::to_string(actual);
+}
+
+std::string describe(const ttt_position& request) {
+    char text[64];
+    std::snprintf(text, sizeof(text), "x=0x%03X o=0x%03X trait=%d", request.x, request.o, request.to_move);
+    return text;
+}
+
+class Report {
+public:
+    Report() : failures(0) {}
+
+    void check(bool ok, const char* engine, const Position& position, const std::string& detail) {
+        if (!ok) fail(engine, describe(position), detail);
+    }
+
+    void check(bool ok, const char* engine, const ttt_position& request, const std::string& detail) {
+        if (!ok) fail(engine, describe(request), detail);
+    }
+
+    int failures;
+
+private:
+    void fail(const char* engine, const std::string& where, const std::string& detail) {
+        if (failures < 20) {
+            std::printf("ÉCART %-10s %s : %s\n", engine, where.c_str(), detail.c_str());
+        }
+        failures++;
+    }
+};
+
+const int GRID_COUNT = 19683;
+
+int gridIndex(const int board[9]) {
+    int index = 0;
+    for (int cell = 8; cell >= 0; cell--) index = index * 3 + board[cell];
+    return index;
+}
+
+// Toutes les positions atteignables depuis la grille vide, calculées avec la référence seule
+void collectReachable(int board[9], int toMove, std::vector<bool>& reachable) {
+    int key = (toMove - 1) * GRID_COUNT + gridIndex(board);
+    if (reachable[key]) return;
+    reachable[key] = true;
+
+    int combo[3];
+    if (referenceWinner(board, combo) != 0) return;
+    for (int cell = 0; cell < 9; cell++) {
+        if (board[cell] != 0) continue;
+        board[cell] = toMove;
+        collectReachable(board, toMove == 1 ? 2 : 1, reachable);
+        board[cell] = 0;
+    }
+}
+
+// Chaque grille et chaque joueur au trait, plus des entrées malformées :
+// le solveur et l'API C ne doivent accepter que les positions atteignables
+void checkValidity(Report& report, int* rejected) {
+    std::vector<bool> reachable(2 * GRID_COUNT, false);
+    int empty[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    collectReachable(empty, 1, reachable);
+    collectReachable(empty, 2, reachable);
+
+    std::vector<ttt_position> requests;
+    std::vector<bool> expected;
+    for (int index = 0; index < GRID_COUNT; index++) {
+        int board[9];
+        int rest = index;
+        for (int cell = 0; cell < 9; cell++) {
+            board[cell] = rest % 3;
+            rest /= 3;
+        }
+        for (int toMove = 1; toMove <= 2; toMove++) {
+            ttt_position request;
+            request.x = boardMask(board, 1);
+            request.o = boardMask(board, 2);
+            request.to_move = static_cast<uint8_t>(toMove);
+            requests.push_back(request);
+            expected.push_back(reachable[(toMove - 1) * GRID_COUNT + index]);
+        }
+    }
+
+    // Cases communes, bits hors grille, joueur au trait inconnu
+    const ttt_position malformed[] = {
+        {0x001, 0x001, 1}, {0x1FF, 0x1FF, 2}, {0x200, 0x000, 2}, {0x000, 0x400, 1},
+        {0xFFFF, 0x0000, 1}, {0x000, 0x000, 0}, {0x001, 0x002, 3}, {0x000, 0x000, 255}
+    };
+    for (const ttt_position& request : malformed) {
+        requests.push_back(request);
+        expected.push_back(false);
+    }
+
+    std::vector<ttt_result> results(requests.size());
+    ttt_analyze_batch(requests.data(), results.data(), requests.size());
+
+    *rejected = 0;
+    for (size_t i = 0; i < requests.size(); i++) {
+        const ttt_position& request = requests[i];
+        bool valid = isValidPosition(request.x, request.o, request.to_move);
+        if (!expected[i]) (*rejected)++;
+
+        report.check(valid == expected[i], "solveur", request, mismatch("position valide", expected[i], valid));
+        report.check((results[i].status == TTT_INVALID) == !expected[i], "lot", request,
+                     mismatch("statut", expected[i] ? TTT_OK : TTT_INVALID, results[i].status));
+    }
+}
+
+void printDistribution(const char* name, std::vector<double> speedups) {
+    if (speedups.empty()) return;
+    std::sort(speedups.begin(), speedups.end());
+    auto percentile = [&](double p) {
+        return speedups[static_cast<size_t>(p * (speedups.size() - 1))];
+    };
+    std::printf("  %-22s min x%-9.1f p10 x%-9.1f p50 x%-9.1f p90 x%-9.1f p99 x%-9.1f max x%.1f\n",
+                name, speedups.front(), percentile(0.10), percentile(0.50),
+                percentile(0.90), percentile(0.99), speedups.back());
+}
+
+volatile long sink;
+
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 1000;
+    uint32_t seed = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1;
+    if (count <= 0) {
+        std::fprintf(stderr, "Usage : fuzz_engines [positions] [graine]\n");
+        return 1;
+    }
+
+    std::vector<Position> positions = randomPositions(count, seed);
+    std::vector<ttt_position> requests(count);
+    for (int i = 0; i < count; i++) {
+        requests[i].x = boardMask(positions[i].board, 1);
+        requests[i].o = boardMask(positions[i].board, 2);
+        requests[i].to_move = static_cast<uint8_t>(positions[i].toMove);
+    }
+
+    // Le gros lot passe par le pool de threads de l'API C
+    std::vector<ttt_position> bulk;
+    while (bulk.size() < (1u << 17)) bulk.insert(bulk.end(), requests.begin(), requests.end());
+    std::vector<ttt_result> bulkResults(bulk.size());
+    ttt_analyze_batch(bulk.data(), bulkResults.data(), bulk.size());
+
+    Report report;
+    int rejected;
+    checkValidity(report, &rejected);
+
+    std::vector<double> tableSpeedups;
+    std::vector<double> batchSpeedups;
+    double referenceSeconds = 0;
+    int terminalCount = 0;
+
+    for (int i = 0; i < count; i++) {
+        const Position& position = positions[i];
+        const ttt_position& request = requests[i];
+        Expected expected = referenceAnalysis(position);
+
+        // Gagnant et fin de partie
+        report.check(ClassicBoard::winner(request.x, request.o) == expected.winner, "Board<3,3>", position,
+                     mismatch("gagnant", expected.winner, ClassicBoard::winner(request.x, request.o)));
+        report.check(isTerminalPosition(request.x, request.o) == expected.terminal, "solveur", position,
+                     mismatch("fin de partie", expected.terminal, isTerminalPosition(request.x, request.o)));
+
+        // API C, position seule puis dans le gros lot (mêmes réponses attendues)
+        ttt_result single;
+        ttt_analyze_batch(&request, &single, 1);
+        for (size_t j = i; j < bulk.size(); j += count) {
+            const ttt_result& r = bulkResults[j];
+            if (r.status != single.status || r.value != single.value
+                || r.distance != single.distance || r.best_moves != single.best_moves) {
+                report.check(false, "lot", position, "résultat différent dans le gros lot");
+                break;
+            }
+        }
+        int expectedStatus = expected.terminal ? TTT_TERMINAL : TTT_OK;
+        report.check(single.status == expectedStatus, "lot", position, mismatch("statut", expectedStatus, single.status));
+
+        if (expected.terminal) {
+            terminalCount++;
+            continue;
+        }
+
+        const SolvedPosition& solved = solvePosition(request.x, request.o, position.toMove);
+        report.check(solved.value == expected.value, "solveur", position, mismatch("valeur", expected.value, solved.value));
+        report.check(expected.value == 0 || solved.distance == expected.distance, "solveur", position,
+                     mismatch("distance", expected.distance, solved.distance));
+        report.check(solved.bestMoves == expected.bestMoves, "solveur", position,
+                     mismatch("meilleurs coups", expected.bestMoves, solved.bestMoves));
+
+        report.check(single.value == expected.value, "lot", position, mismatch("valeur", expected.value, single.value));
+        report.check(expected.value == 0 || single.distance == expected.distance, "lot", position,
+                     mismatch("distance", expected.distance, single.distance));
+        report.check(single.best_moves == expected.bestMoves, "lot", position,
+                     mismatch("meilleurs coups", expected.bestMoves, single.best_moves));
+
+        // L'IA Difficile joue O et garde le premier des meilleurs coups
+        if (position.toMove == 2) {
+            int board[9];
+            std::copy(position.board, position.board + 9, board);
+            int move = referenceBestMove(board);
+            int firstBest = __builtin_ctz(expected.bestMoves);
+            report.check(move == firstBest, "Difficile", position, mismatch("coup", firstBest, move));
+            report.check(move >= 0 && (solved.bestMoves >> move & 1), "solveur", position,
+                         mismatch("coup de l'IA hors des meilleurs coups", move, solved.bestMoves));
+        }
+
+        // Accélérations par position
+        double referenceTime = secondsPerCall([&] {
+            int board[9];
+            std::copy(position.board, position.board + 9, board);
+            sink = sink + referenceMinimax(board, 0, position.toMove == 2);
+        });
+        double tableTime = secondsPerCall([&] {
+            sink = sink + solvePosition(request.x, request.o, position.toMove).bestMoves;
+        });
+        double batchTime = secondsPerCall([&] {
+            ttt_result result;
+            ttt_analyze_batch(&request, &result, 1);
+            sink = sink + result.best_moves;
+        });
+        referenceSeconds += referenceTime;
+        tableSpeedups.push_back(referenceTime / tableTime);
+        batchSpeedups.push_back(referenceTime / batchTime);
+    }
+
+    // Débit du gros lot comparé au minimax de référence sur les mêmes positions
+    Clock::time_point start = Clock::now();
+    ttt_analyze_batch(bulk.data(), bulkResults.data(), bulk.size());
+    double bulkRate = bulk.size() / secondsSince(start);
+    int analyzed = count - terminalCount;
+    double referenceRate = analyzed > 0 ? analyzed / referenceSeconds : 0;
+
+    std::printf("Validité : %d grilles x 2 joueurs au trait et 8 entrées malformées, %d rejetées\n",
+                GRID_COUNT, rejected);
+    std::printf("%d positions (%d terminées), graine %u\n", count, terminalCount, seed);
+    std::printf("Accélération par position par rapport au minimax de référence :\n");
+    printDistribution("solveur (table)", tableSpeedups);
+    printDistribution("API C, une position", batchSpeedups);
+    std::printf("Débit : référence %.0f positions/s, API C par lots %.0f positions/s (%zu positions)\n",
+                referenceRate, bulkRate, bulk.size());
+
+    if (report.failures != 0) {
+        std::printf("%d écart(s) détecté(s)\n", report.failures);
+        return 1;
+    }
+    std::printf("Aucun écart\n");
+    return 0;
+}
@@ -0,0 +1,220 @@
+// Outils du réseau d'évaluation du Qubic :
+//   nnue_tool bench [poids.nnue]                  évaluations/s heuristique vs réseau
+//   nnue_tool export <parties> <sortie> [ms]      données d'entraînement par auto-jeu
+//   nnue_tool init <sortie> [graine]              poids aléatoires
+//
+// Format d'export : une position par enregistrement de 18 octets (petit-boutiste)
+//   uint64 pierres de X, uint64 pierres de O, uint8 joueur au trait (1 X, 2 O),
+//   int8 résultat final pour le joueur au trait (1 gain, 0 nul, -1 perte)
+
+#include "../nnue.h"
+#include "../qubic.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Positions aléatoires atteignables (sans ligne complète)
+std::vector<QubicBoard> randomPositions(int count, uint32_t seed) {
+    std::srand(seed);
+    std::vector<QubicBoard> positions;
+
+    while (static_cast<int>(positions.size()) < count) {
+        QubicBoard board;
+        board.reset(1 + std::rand() % 2);
+        int plies = 4 + std::rand() % 36;
+        for (int k = 0; k < plies && board.winner == 0; k++) {
+            int move;
+            do move = std::rand() % QubicBoard::CELL_COUNT; while (!board.isLegal(move));
+            board.play(move);
+        }
+        if (board.winner == 0) positions.push_back(board);
+    }
+    return positions;
+}
+
+int bench(const std::string& weightsPath) {
+    NnueNetwork network;
+    if (weightsPath.empty()) {
+        network.randomize(12345);
+        std::cout << "Poids aléatoires (mesure de vitesse uniquement)" << std::endl;
+    } else if (!network.load(weightsPath)) {
+        std::cerr << "Impossible de charger " << weightsPath << std::endl;
+        return 1;
+    }
+
+    const int POSITIONS = 4096;
+    const int ROUNDS = 200;
+    std::vector<QubicBoard> positions = randomPositions(POSITIONS, 7);
+    long checksum = 0;
+
+    // Heuristique : 76 lignes parcourues à chaque appel
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (const QubicBoard& board : positions) {
+            checksum += qubicEvaluate(board.stones[board.currentPlayer - 1], board.stones[2 - board.currentPlayer]);
+        }
+    }
+    double heuristicRate = POSITIONS * static_cast<double>(ROUNDS) / secondsSince(start);
+
+    // Réseau, recalcul complet de l'accumulateur
+    NnueNetwork::Accumulator accumulator;
+    start = Clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (const QubicBoard& board : positions) {
+            network.refresh(accumulator, board.stones[0], board.stones[1]);
+            checksum += network.evaluate(accumulator, board.currentPlayer - 1);
+        }
+    }
+    double refreshRate = POSITIONS * static_cast<double>(ROUNDS) / secondsSince(start);
+
+    // Réseau, mise à jour incrémentale (un coup joué puis évaluation), comme dans la recherche
+    std::vector<NnueNetwork::Accumulator> parents(POSITIONS);
+    std::vector<int> moves(POSITIONS);
+    int mismatches = 0;
+    for (int i = 0; i < POSITIONS; i++) {
+        const QubicBoard& board = positions[i];
+        network.refresh(parents[i], board.stones[0], board.stones[1]);
+        moves[i] = __builtin_ctzll(~(board.stones[0] | board.stones[1]));
+
+        NnueNetwork::Accumulator incremental;
+        NnueNetwork::Accumulator full;
+        network.addStone(parents[i], incremental, moves[i], board.currentPlayer - 1);
+        uint64_t bit = 1ULL << moves[i];
+        network.refresh(full, board.stones[0] | (board.currentPlayer == 1 ? bit : 0),
+                        board.stones[1] | (board.currentPlayer == 2 ? bit : 0));
+        for (int side = 0; side < 2; side++) {
+            if (network.evaluate(incremental, side) != network.evaluate(full, side)) mismatches++;
+        }
+    }
+
+    start = Clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < POSITIONS; i++) {
+            network.addStone(parents[i], accumulator, moves[i], positions[i].currentPlayer - 1);
+            checksum += network.evaluate(accumulator, 2 - positions[i].currentPlayer);
+        }
+    }
+    double incrementalRate = POSITIONS * static_cast<double>(ROUNDS) / secondsSince(start);
+
+    std::printf("Évaluations par seconde (%d positions x %d) :\n", POSITIONS, ROUNDS);
+    std::printf("  heuristique             %8.2f M/s\n", heuristicRate / 1e6);
+    std::printf("  réseau, recalcul        %8.2f M/s\n", refreshRate / 1e6);
+    std::printf("  réseau, incrémental     %8.2f M/s\n", incrementalRate / 1e6);
+    std::printf("  écarts incrémental/recalcul : %d\n", mismatches);
+
+    // Recherche complète à temps fixe avec chaque évaluation. Les coups joués
+    // sans alpha-beta (menace immédiate, gain forcé) sont écartés, et chaque
+    // appel est chronométré : une recherche qui conclut avant l'échéance
+    // ne doit pas être comptée comme ayant duré SEARCH_MS.
+    const int SEARCH_MS = 200;
+    const int SEARCHES = 8;
+    long nodes[2] = {0, 0};
+    double seconds[2] = {0, 0};
+    int searched = 0;
+    for (int i = 0; i < POSITIONS && searched < SEARCHES; i++) {
+        QubicSearchInfo info[2];
+        double elapsed[2];
+        for (int e = 0; e < 2; e++) {
+            Clock::time_point searchStart = Clock::now();
+            qubicBestMove(positions[i], SEARCH_MS, &info[e], e == 0 ? nullptr : &network);
+            elapsed[e] = secondsSince(searchStart);
+        }
+        if (info[0].searchDepth == 0 || info[1].searchDepth == 0) continue;
+        for (int e = 0; e < 2; e++) {
+            nodes[e] += info[e].nodes;
+            seconds[e] += elapsed[e];
+        }
+        searched++;
+    }
+    if (searched == 0) {
+        std::printf("Alpha-beta : aucune position ne demande de recherche\n");
+    } else {
+        std::printf("Alpha-beta (%d positions, %d ms max, menaces incluses dans le temps) : "
+                    "heuristique %.0f nœuds/s, réseau %.0f nœuds/s\n",
+                    searched, SEARCH_MS, nodes[0] / seconds[0], nodes[1] / seconds[1]);
+    }
+
+    // Empêche le compilateur d'éliminer les boucles mesurées
+    volatile long sink = checksum;
+    (void)sink;
+    return 0;
+}
+
+int exportSelfPlay(int games, const std::string& outputPath, int moveTimeMs) {
+    FILE* output = std::fopen(outputPath.c_str(), "wb");
+    if (!output) {
+        std::cerr << "Impossible d'écrire " << outputPath << std::endl;
+        return 1;
+    }
+
+    const int RANDOM_OPENING_PLIES = 4;
+    std::srand(static_cast<unsigned>(Clock::now().time_since_epoch().count()));
+    long records = 0;
+
+    for (int game = 0; game < games; game++) {
+        QubicBoard board;
+        board.reset(1 + game % 2);
+        std::vector<QubicBoard> history;
+
+        for (int ply = 0; board.winner == 0; ply++) {
+            int move;
+            if (ply < RANDOM_OPENING_PLIES) {
+                do move = std::rand() % QubicBoard::CELL_COUNT; while (!board.isLegal(move));
+            } else {
+                history.push_back(board);
+                move = qubicBestMove(board, moveTimeMs, nullptr);
+            }
+            board.play(move);
+        }
+
+        for (const QubicBoard& position : history) {
+            uint8_t toMove = static_cast<uint8_t>(position.currentPlayer);
+            int8_t result = board.winner == 3 ? 0 : (board.winner == position.currentPlayer ? 1 : -1);
+            std::fwrite(&position.stones[0], sizeof(uint64_t), 1, output);
+            std::fwrite(&position.stones[1], sizeof(uint64_t), 1, output);
+            std::fwrite(&toMove, 1, 1, output);
+            std::fwrite(&result, 1, 1, output);
+            records++;
+        }
+
+        std::cout << "Partie " << game + 1 << "/" << games << " : "
+                  << (board.winner == 3 ? "nul" : (board.winner == 1 ? "X gagne" : "O gagne"))
+                  << ", " << history.size() << " positions" << std::endl;
+    }
+
+    std::fclose(output);
+    std::cout << records << " positions écrites dans " << outputPath << std::endl;
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string command = argc > 1 ? argv[1] : "";
+
+    if (command == "bench") {
+        return bench(argc > 2 ? argv[2] : "");
+    }
+    if (command == "export" && argc > 3) {
+        return exportSelfPlay(std::atoi(argv[2]), argv[3], argc > 4 ? std::atoi(argv[4]) : 20);
+    }
+    if (command == "init" && argc > 2) {
+        NnueNetwork network;
+        network.randomize(argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 1);
+        return network.save(argv[2]) ? 0 : 1;
+    }
+
+    std::cerr << "Usage : nnue_tool bench [poids.nnue] | export <parties> <sortie> [ms] | init <sortie> [graine]" << std::endl;
+    return 1;
+}
@@ -0,0 +1,337 @@
+#include "ultimate.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+const uint16_t UltimateBoard::LINE_MASKS[8] = {
+    0x007, 0x038, 0x1C0,
+    0x049, 0x092, 0x124,
+    0x111, 0x054
+};
+
+namespace {
+
+// Tables précalculées pour les 512 grilles 9 bits possibles
+struct MaskTables {
+    bool win[512];
+    uint8_t count[512];
+
+    MaskTables() {
+        for (int mask = 0; mask < 512; mask++) {
+            win[mask] = false;
+            for (int i = 0; i < 8; i++) {
+                if ((mask & UltimateBoard::LINE_MASKS[i]) == UltimateBoard::LINE_MASKS[i]) {
+                    win[mask] = true;
+                }
+            }
+
+            count[mask] = 0;
+            for (int bit = 0; bit < 9; bit++) {
+                if (mask & (1 << bit)) count[mask]++;
+            }
+        }
+    }
+};
+
+const MaskTables tables;
+
+// Index du n-ième bit à 1 d'un masque 9 bits
+int nthBit(uint16_t mask, int n) {
+    for (int bit = 0; bit < 9; bit++) {
+        if (mask & (1 << bit)) {
+            if (n == 0) return bit;
+            n--;
+        }
+    }
+    return -1;
+}
+
+// Générateur xorshift pour les parties aléatoires
+struct Random {
+    uint32_t state;
+
+    explicit Random(uint32_t seed) : state(seed ? seed : 0x9E3779B9u) {}
+
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    int below(int n) {
+        return static_cast<int>(next() % static_cast<uint32_t>(n));
+    }
+};
+
+// Nœud de l'arbre Monte-Carlo, score du point de vue du joueur qui a joué le coup
+struct Node {
+    int parent;
+    int firstChild;
+    int childCount;
+    int move;
+    int player;
+    int visits;
+    float score;
+};
+
+const int MAX_NODES = 1 << 19;
+const float EXPLORATION = 1.4f;
+
+// Pool de nœuds réutilisé d'un coup à l'autre
+std::vector<Node>& nodePool() {
+    static std::vector<Node> pool;
+    if (pool.capacity() < static_cast<size_t>(MAX_NODES)) {
+        pool.reserve(MAX_NODES);
+    }
+    return pool;
+}
+
+// Coup aléatoire sans construire la liste complète des coups légaux
+int randomMove(const UltimateBoard& board, Random& random) {
+    if (board.activeBoard != -1) {
+        int sub = board.activeBoard;
+        uint16_t empty = ~(board.cells[0][sub] | board.cells[1][sub]) & UltimateBoard::FULL_MASK;
+        return sub * 9 + nthBit(empty, random.below(tables.count[empty]));
+    }
+
+    int total = 0;
+    for (int sub = 0; sub < 9; sub++) {
+        if (board.closed & (1 << sub)) continue;
+        uint16_t empty = ~(board.cells[0][sub] | board.cells[1][sub]) & UltimateBoard::FULL_MASK;
+        total += tables.count[empty];
+    }
+
+    int n = random.below(total);
+    for (int sub = 0; sub < 9; sub++) {
+        if (board.closed & (1 << sub)) continue;
+        uint16_t empty = ~(board.cells[0][sub] | board.cells[1][sub]) & UltimateBoard::FULL_MASK;
+        if (n < tables.count[empty]) return sub * 9 + nthBit(empty, n);
+        n -= tables.count[empty];
+    }
+    return -1;
+}
+
+// Score d'une fin de partie pour un joueur donné
+float resultFor(int winner, int player) {
+    if (winner == 3) return 0.5f;
+    return winner == player ? 1.0f : 0.0f;
+}
+
+}
+
+// Constructeur
+UltimateBoard::UltimateBoard() {
+    reset(1);
+}
+
+// Réinitialiser le plateau
+void UltimateBoard::reset(int firstPlayer) {
+    for (int sub = 0; sub < 9; sub++) {
+        cells[0][sub] = 0;
+        cells[1][sub] = 0;
+    }
+    meta[0] = 0;
+    meta[1] = 0;
+    closed = 0;
+    activeBoard = -1;
+    currentPlayer = firstPlayer;
+    winner = 0;
+}
+
+// Test de victoire d'une grille 9 bits
+bool UltimateBoard::isWinningMask(uint16_t mask) {
+    return tables.win[mask & FULL_MASK];
+}
+
+// Jouer un coup (supposé légal)
+void UltimateBoard::play(int move) {
+    int sub = move / 9;
+    int cell = move % 9;
+    int side = currentPlayer - 1;
+
+    cells[side][sub] |= 1 << cell;
+
+    if (tables.win[cells[side][sub]]) {
+        meta[side] |= 1 << sub;
+        closed |= 1 << sub;
+        if (tables.win[meta[side]]) {
+            winner = currentPlayer;
+        }
+    } else if ((cells[0][sub] | cells[1][sub]) == FULL_MASK) {
+        closed |= 1 << sub;
+    }
+
+    if (winner == 0 && closed == FULL_MASK) {
+        winner = 3;
+    }
+
+    activeBoard = (closed & (1 << cell)) ? -1 : cell;
+    currentPlayer = (currentPlayer == 1) ? 2 : 1;
+}
+
+// Vérifier qu'un coup est légal
+bool UltimateBoard::isLegal(int move) const {
+    if (winner != 0 || move < 0 || move >= CELL_COUNT) return false;
+
+    int sub = move / 9;
+    int cell = move % 9;
+
+    if (closed & (1 << sub)) return false;
+    if (activeBoard != -1 && activeBoard != sub) return false;
+    return ((cells[0][sub] | cells[1][sub]) & (1 << cell)) == 0;
+}
+
+// Lister les coups légaux, renvoie leur nombre
+int UltimateBoard::legalMoves(int* moves) const {
+    int count = 0;
+    if (winner != 0) return 0;
+
+    for (int sub = 0; sub < 9; sub++) {
+        if (closed & (1 << sub)) continue;
+        if (activeBoard != -1 && activeBoard != sub) continue;
+
+        uint16_t empty = ~(cells[0][sub] | cells[1][sub]) & FULL_MASK;
+        for (int cell = 0; cell < 9; cell++) {
+            if (empty & (1 << cell)) {
+                moves[count++] = sub * 9 + cell;
+            }
+        }
+    }
+    return count;
+}
+
+// Occupant d'une case (0 vide, 1 X, 2 O)
+int UltimateBoard::cellOwner(int move) const {
+    int sub = move / 9;
+    int bit = 1 << (move % 9);
+    if (cells[0][sub] & bit) return 1;
+    if (cells[1][sub] & bit) return 2;
+    return 0;
+}
+
+// État d'une sous-grille (0 ouverte, 1 X, 2 O, 3 pleine sans gagnant)
+int UltimateBoard::boardOwner(int sub) const {
+    if (meta[0] & (1 << sub)) return 1;
+    if (meta[1] & (1 << sub)) return 2;
+    if (closed & (1 << sub)) return 3;
+    return 0;
+}
+
+// Retrouver la ligne gagnante sur la grille principale
+bool UltimateBoard::metaWinningLine(int player, int combo[3]) const {
+    uint16_t mask = meta[player - 1];
+
+    for (int i = 0; i < 8; i++) {
+        if ((mask & LINE_MASKS[i]) == LINE_MASKS[i]) {
+            int n = 0;
+            for (int bit = 0; bit < 9; bit++) {
+                if (LINE_MASKS[i] & (1 << bit)) combo[n++] = bit;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// Recherche Monte-Carlo (UCT) dans la limite de temps donnée
+int ultimateBestMove(const UltimateBoard& board, int timeLimitMs) {
+    int moves[UltimateBoard::CELL_COUNT];
+    int moveCount = board.legalMoves(moves);
+    if (moveCount == 0) return -1;
+    if (moveCount == 1) return moves[0];
+
+    // Victoire immédiate : inutile de chercher plus loin
+    for (int i = 0; i < moveCount; i++) {
+        UltimateBoard next = board;
+        next.play(moves[i]);
+        if (next.winner == board.currentPlayer) return moves[i];
+    }
+
+    std::vector<Node>& pool = nodePool();
+    pool.clear();
+    pool.push_back({-1, -1, 0, -1, (board.currentPlayer == 1) ? 2 : 1, 0, 0.0f});
+
+    Random random(static_cast<uint32_t>(std::rand()) * 2654435761u + 1);
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(timeLimitMs);
+
+    for (int iteration = 0; ; iteration++) {
+        if ((iteration & 63) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+
+        UltimateBoard state = board;
+        int nodeIndex = 0;
+
+        // Sélection
+        while (pool[nodeIndex].firstChild != -1 && state.winner == 0) {
+            const Node& node = pool[nodeIndex];
+            float logVisits = std::log(static_cast<float>(node.visits));
+            int bestChild = node.firstChild;
+            float bestValue = -1.0f;
+
+            for (int c = node.firstChild; c < node.firstChild + node.childCount; c++) {
+                const Node& child = pool[c];
+                if (child.visits == 0) {
+                    bestChild = c;
+                    break;
+                }
+                float value = child.score / child.visits
+                    + EXPLORATION * std::sqrt(logVisits / child.visits);
+                if (value > bestValue) {
+                    bestValue = value;
+                    bestChild = c;
+                }
+            }
+
+            nodeIndex = bestChild;
+            state.play(pool[nodeIndex].move);
+        }
+
+        // Expansion
+        if (state.winner == 0 && pool[nodeIndex].firstChild == -1) {
+            int childMoves[UltimateBoard::CELL_COUNT];
+            int childCount = state.legalMoves(childMoves);
+
+            if (pool.size() + childCount <= static_cast<size_t>(MAX_NODES)) {
+                int first = static_cast<int>(pool.size());
+                for (int i = 0; i < childCount; i++) {
+                    pool.push_back({nodeIndex, -1, 0, childMoves[i], state.currentPlayer, 0, 0.0f});
+                }
+                pool[nodeIndex].firstChild = first;
+                pool[nodeIndex].childCount = childCount;
+
+                nodeIndex = first + random.below(childCount);
+                state.play(pool[nodeIndex].move);
+            }
+        }
+
+        // Simulation
+        while (state.winner == 0) {
+            state.play(randomMove(state, random));
+        }
+
+        // Rétropropagation
+        while (nodeIndex != -1) {
+            Node& node = pool[nodeIndex];
+            node.visits++;
+            node.score += resultFor(state.winner, node.player);
+            nodeIndex = node.parent;
+        }
+    }
+
+    // Coup le plus visité
+    const Node& root = pool[0];
+    int bestMove = moves[0];
+    int bestVisits = -1;
+    for (int c = root.firstChild; c < root.firstChild + root.childCount; c++) {
+        if (pool[c].visits > bestVisits) {
+            bestVisits = pool[c].visits;
+            bestMove = pool[c].move;
+        }
+    }
+    return bestMove;
+}
@@ -0,0 +1,42 @@
+#ifndef ULTIMATE_H
+#define ULTIMATE_H
+
+#include <cstdint>
+
+// Morpion ultime : neuf sous-grilles 3x3, chaque coup envoie l'adversaire
+// dans la sous-grille correspondant à la case jouée.
+// Un coup est codé sous la forme sousGrille * 9 + case (0 à 80).
+class UltimateBoard {
+public:
+    static const int CELL_COUNT = 81;
+    static const uint16_t FULL_MASK = 0x1FF;
+
+    // Lignes gagnantes d'une grille 3x3 sous forme de masques 9 bits
+    static const uint16_t LINE_MASKS[8];
+
+    uint16_t cells[2][9];   // cases de X (0) et de O (1) dans chaque sous-grille
+    uint16_t meta[2];       // sous-grilles gagnées par X et par O
+    uint16_t closed;        // sous-grilles terminées (gagnées ou pleines)
+    int activeBoard;        // sous-grille imposée, -1 si le choix est libre
+    int currentPlayer;      // 1 = X, 2 = O
+    int winner;             // 0 en cours, 1 = X, 2 = O, 3 = nul
+
+    UltimateBoard();
+
+    void reset(int firstPlayer);
+    void play(int move);
+
+    bool isLegal(int move) const;
+    int legalMoves(int* moves) const;
+    int cellOwner(int move) const;
+    int boardOwner(int sub) const;
+    bool metaWinningLine(int player, int combo[3]) const;
+
+    // Test de victoire d'une grille 9 bits via la table de 512 entrées
+    static bool isWinningMask(uint16_t mask);
+};
+
+// Meilleur coup pour le joueur au trait (recherche Monte-Carlo limitée en temps)
+int ultimateBestMove(const UltimateBoard& board, int timeLimitMs);
+
+#endif